@@ -0,0 +1,212 @@
+//============================== EditorAssets.cpp ===============================
+#include "EditorAssets.h"
+#include "GoldenKnobLNF.h"
+
+//==============================================================================
+EditorAssets::Worker::Worker()
+{
+    // Créée ici (thread message), seulement copiée ensuite par les tâches
+    self = this;
+}
+
+EditorAssets::Worker::~Worker()
+{
+    // Dernière instance détruite: un rendu en cours livrera dans le vide (self nul)
+    masterReference.clear();
+}
+
+EditorAssets::Set::Ptr EditorAssets::Worker::find (Key key)
+{
+    for (auto it = cache.begin(); it != cache.end(); ++it)
+    {
+        if (it->first == key)
+        {
+            auto entry = *it;
+            cache.erase (it);
+            cache.push_back (entry);
+            return entry.second;
+        }
+    }
+
+    return nullptr;
+}
+
+void EditorAssets::Worker::completed (Key key, Set::Ptr set)
+{
+    cache.emplace_back (key, set);
+    if ((int) cache.size() > kMaxCached)
+        cache.erase (cache.begin());
+
+    // Remise à tous les éditeurs qui attendent encore cette géométrie
+    auto it = waiting.find (key);
+    if (it == waiting.end())
+        return;
+
+    const auto listeners = it->second;
+    waiting.erase (it);
+
+    for (auto& l : listeners)
+        if (auto* assets = l.get())
+            if (assets->wantedKey == key)
+                assets->deliver (set);
+}
+
+//==============================================================================
+EditorAssets::EditorAssets (Callback callback)
+    : onReady (std::move (callback))
+{
+}
+
+EditorAssets::~EditorAssets()
+{
+    stopTimer();
+}
+
+EditorAssets::Key EditorAssets::keyFor (float uiScale, int knobSize, float pixelScale) noexcept
+{
+    return ((Key) juce::roundToInt (uiScale * 1000.0f) << 40)
+         | ((Key) (knobSize & 0xfffff) << 20)
+         |  (Key) juce::roundToInt (pixelScale * 100.0f);
+}
+
+void EditorAssets::request (float uiScale, int knobSize, float pixelScale)
+{
+    const auto key = keyFor (uiScale, knobSize, pixelScale);
+    if (key == wantedKey)
+        return;
+
+    wantedKey        = key;
+    wantedScale      = uiScale;
+    wantedKnobSize   = knobSize;
+    wantedPixelScale = pixelScale;
+
+    if (auto set = worker->find (key))
+    {
+        stopTimer();
+        deliver (set);
+        return;
+    }
+
+    // Ouverture: rendu lancé tout de suite; redimensionnement: une seule tâche à la fin
+    if (current == nullptr)
+        schedule();
+    else
+        startTimer (120);
+}
+
+void EditorAssets::timerCallback()
+{
+    stopTimer();
+    schedule();
+}
+
+void EditorAssets::schedule()
+{
+    auto& w = *worker;
+
+    if (auto set = w.find (wantedKey))
+    {
+        deliver (set);
+        return;
+    }
+
+    // Une seule tâche par géométrie, quel que soit le nombre d'éditeurs en attente
+    auto& listeners = w.waiting[wantedKey];
+    const bool inFlight = ! listeners.isEmpty();
+    listeners.add (this);
+
+    if (inFlight)
+        return;
+
+    w.pool.addJob ([self = w.self, key = wantedKey, s = wantedScale, k = wantedKnobSize, ps = wantedPixelScale]
+    {
+        auto set = build (s, k, ps);
+
+        juce::MessageManager::callAsync ([self, key, set]
+        {
+            if (auto* owner = self.get())
+                owner->completed (key, set);
+        });
+    });
+}
+
+void EditorAssets::deliver (Set::Ptr set)
+{
+    current = set;
+
+    if (onReady != nullptr)
+        onReady (set);
+}
+
+//==============================================================================
+EditorAssets::Set::Ptr EditorAssets::build (float uiScale, int knobSize, float pixelScale)
+{
+    Set::Ptr set = new Set();
+    set->uiScale    = uiScale;
+    set->knobSize   = knobSize;
+    set->pixelScale = pixelScale;
+
+    // Halo doré pleine intensité: l'éditeur l'étire au rayon voulu et module l'opacité
+    {
+        juce::Image img (juce::Image::ARGB, kHaloSize, kHaloSize, true, juce::SoftwareImageType());
+        juce::Graphics g (img);
+
+        const float c = (float) kHaloSize * 0.5f;
+        const auto c0 = juce::Colour::fromRGB (255,250,210).withAlpha (0.98f);
+        const auto c1 = juce::Colour::fromRGB (255,236,160).withAlpha (0.75f);
+        const auto c2 = juce::Colour::fromRGB (255,220,120).withAlpha (0.34f);
+        const auto c3 = juce::Colour::fromRGB (255,220,120).withAlpha (0.00f);
+
+        juce::ColourGradient grad (c0, c, c, c3, 0.0f, c, true);
+        grad.addColour (0.25, c1);
+        grad.addColour (0.70, c2);
+        g.setGradientFill (grad);
+        g.fillEllipse (0.0f, 0.0f, (float) kHaloSize, (float) kHaloSize);
+
+        set->halo = img;
+    }
+
+    // Corps du bouton: une image par niveau de brillance, à la densité de l'écran
+    if (knobSize > 4)
+    {
+        const int fs = juce::roundToInt ((float) knobSize * pixelScale);
+        juce::Image strip (juce::Image::ARGB, fs, fs * kKnobFrames, true, juce::SoftwareImageType());
+        juce::Graphics g (strip);
+
+        const float half = (float) knobSize * 0.5f;
+        for (int f = 0; f < kKnobFrames; ++f)
+        {
+            juce::Graphics::ScopedSaveState state (g);
+            g.addTransform (juce::AffineTransform::scale (pixelScale).translated (0.0f, (float) (f * fs)));
+            GoldenKnobLNF::drawBody (g, half, half, half - 2.0f, (float) f / (float) (kKnobFrames - 1));
+        }
+
+        set->knobFrames    = strip;
+        set->knobFrameSize = fs;
+    }
+
+    // Palette des mètres: blanc discret → or → rouge près du plein niveau
+    {
+        juce::Image img (juce::Image::ARGB, 256, 1, true, juce::SoftwareImageType());
+        juce::Graphics g (img);
+
+        juce::ColourGradient grad (juce::Colours::white.withAlpha (0.40f), 0.0f, 0.0f,
+                                   juce::Colour::fromRGB (230,80,60).withAlpha (0.80f), 256.0f, 0.0f, false);
+        grad.addColour (0.70, juce::Colour::fromRGB (255,224,120).withAlpha (0.60f));
+        grad.addColour (0.90, juce::Colour::fromRGB (255,210,90).withAlpha (0.75f));
+        g.setGradientFill (grad);
+        g.fillAll();
+
+        set->levelColours = img;
+    }
+
+    // Libellés des mètres: mise en forme faite une fois, redessinée à chaque image
+    {
+        const juce::Font font (16.0f * uiScale);
+        const float w = 40.0f * uiScale, h = 20.0f * uiScale;
+        set->inLabel .addFittedText (font, "IN",  0.0f, 0.0f, w, h, juce::Justification::centredLeft, 1);
+        set->outLabel.addFittedText (font, "OUT", 0.0f, 0.0f, w, h, juce::Justification::centredLeft, 1);
+    }
+
+    return set;
+}
@@ -0,0 +1,101 @@
+//============================== EditorAssets.h ===============================
+#pragma once
+#include <JuceHeader.h>
+#include <functional>
+#include <map>
+#include <vector>
+
+/**
+ * Ressources graphiques coûteuses de l'éditeur, préparées hors thread message.
+ *
+ * L'éditeur peint d'abord un cadre vectoriel léger; un ThreadPool partagé par
+ * toutes les instances rend en arrière-plan le halo, les images du corps du
+ * bouton, la palette des mètres et la mise en page des libellés, puis remet le
+ * jeu au thread message (callAsync). Un jeu publié est immuable et mis en cache
+ * par échelle. Le cache est tenu par les processeurs (KeepAlive), pas par les
+ * éditeurs: un éditeur ouvert après la fermeture d'un autre l'obtient sans attendre.
+ */
+class EditorAssets : private juce::Timer
+{
+public:
+    static constexpr int kHaloSize   = 256;    // dégradé lisse: agrandi sans perte visible
+    static constexpr int kKnobFrames = 16;     // niveaux de brillance du corps du bouton
+    static constexpr int kMaxCached  = 4;
+
+    // Jeu complet pour une échelle UI et une densité d'affichage données
+    struct Set : public juce::ReferenceCountedObject
+    {
+        using Ptr = juce::ReferenceCountedObjectPtr<Set>;
+
+        float uiScale    = 1.0f;
+        int   knobSize   = 0;           // côté logique du bouton
+        float pixelScale = 1.0f;
+
+        juce::Image halo;               // halo pleine intensité, rayon = demi-côté
+        juce::Image knobFrames;         // kKnobFrames corps empilés verticalement
+        int         knobFrameSize = 0;  // côté d'une image, en pixels physiques
+        juce::Image levelColours;       // palette 256 × 1 des mètres (0 → 1)
+
+        juce::GlyphArrangement inLabel, outLabel;   // relatifs à leur coin haut-gauche
+    };
+
+    using Callback = std::function<void (Set::Ptr)>;
+
+    explicit EditorAssets (Callback onReady);
+    ~EditorAssets() override;
+
+    // Thread message: jeu voulu pour cette géométrie. Servi depuis le cache si
+    // possible, sinon construit en arrière-plan (regroupé pendant un redimensionnement).
+    void request (float uiScale, int knobSize, float pixelScale);
+
+    Set::Ptr getCurrent() const noexcept        { return current; }
+
+private:
+    using Key = juce::int64;
+    static Key keyFor (float uiScale, int knobSize, float pixelScale) noexcept;
+
+    // Thread du pool: rendu complet, sans accès à l'éditeur
+    static Set::Ptr build (float uiScale, int knobSize, float pixelScale);
+
+    // Pool + cache partagés (cache et attentes: thread message uniquement)
+    struct Worker
+    {
+        Worker();
+        ~Worker();
+
+        Set::Ptr find (Key);
+        void completed (Key, Set::Ptr);
+
+        std::vector<std::pair<Key, Set::Ptr>> cache;    // LRU, plus récent en fin
+        std::map<Key, juce::Array<juce::WeakReference<EditorAssets>>> waiting;
+
+        juce::ThreadPool pool { 1, 0, juce::Thread::Priority::low };
+        juce::WeakReference<Worker> self;
+
+        JUCE_DECLARE_WEAK_REFERENCEABLE (Worker)
+    };
+
+public:
+    // Tenu par chaque processeur: pool et cache vivent tant qu'une instance existe
+    struct KeepAlive
+    {
+        juce::SharedResourcePointer<Worker> worker;
+    };
+
+private:
+
+    void timerCallback() override;
+    void schedule();
+    void deliver (Set::Ptr);
+
+    Callback onReady;
+    Set::Ptr current;
+    Key   wantedKey = -1;
+    float wantedScale = 1.0f, wantedPixelScale = 1.0f;
+    int   wantedKnobSize = 0;
+
+    juce::SharedResourcePointer<Worker> worker;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (EditorAssets)
+    JUCE_DECLARE_NON_COPYABLE (EditorAssets)
+};
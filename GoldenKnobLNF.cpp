@@ -2,6 +2,33 @@
 #include "GoldenKnobLNF.h"
 #include <cmath>
 
+void GoldenKnobLNF::drawBody (juce::Graphics& g, float cx, float cy, float r, float glow)
+{
+    // Ombre portée douce
+    g.setColour (juce::Colours::black.withAlpha (0.35f));
+    g.fillEllipse (cx - r, cy - r + 2.0f, r * 2.0f, r * 2.0f);
+
+    // Corps doré (réagit à glow)
+    glow = juce::jlimit (0.0f, 1.0f, glow);
+    juce::Colour cMid  = goldMid();
+    juce::Colour cDark = goldDark();
+    juce::Colour cHi   = goldBright().withMultipliedBrightness (1.0f + 0.6f * glow);
+
+    juce::ColourGradient body (cMid,  cx, cy,
+                               cDark, cx, cy - r, true);
+    body.addColour (0.15, cHi);
+    body.addColour (0.50, cDark);
+    body.addColour (0.85, cHi);
+    g.setGradientFill (body);
+    g.fillEllipse (cx - r, cy - r, r * 2.0f, r * 2.0f);
+
+    // Biseaux
+    g.setColour (goldEdge().withAlpha (0.55f + 0.3f * glow));
+    g.drawEllipse (cx - r, cy - r, r * 2.0f, r * 2.0f, 1.5f);
+    g.setColour (juce::Colours::black.withAlpha (0.35f));
+    g.drawEllipse (cx - r + 2.0f, cy - r + 2.0f, (r - 2.0f) * 2.0f, (r - 2.0f) * 2.0f, 1.0f);
+}
+
 void GoldenKnobLNF::drawRotarySlider (juce::Graphics& g, int x, int y, int w, int h,
                                       float sliderPos, const float rotaryStart,
                                       const float rotaryEnd, juce::Slider& s)
@@ -12,30 +39,20 @@ void GoldenKnobLNF::drawRotarySlider (juce::Graphics& g, int x, int y, int w, in
     const float cy = y + h * 0.5f;
     const float r  = juce::jmin ((float) w, (float) h) * 0.5f - 2.0f;
 
-    // Ombre portée douce
-    g.setColour (juce::Colours::black.withAlpha (0.35f));
-    g.fillEllipse (cx - r, cy - r + 2.0f, r * 2.0f, r * 2.0f);
+    // Corps: image précalculée si elle correspond à cette taille, sinon vectoriel
+    const int side = juce::jmin (w, h);
+    const int numFrames = bodyFrameSize > 0 ? bodyFrames.getHeight() / bodyFrameSize : 0;
 
-    // Corps doré (réagit à intensity)
+    if (numFrames > 0 && juce::roundToInt ((float) side * bodyPixelScale) == bodyFrameSize)
     {
-        const float glow = juce::jlimit (0.0f, 1.0f, intensity);
-        juce::Colour cMid  = goldMid();
-        juce::Colour cDark = goldDark();
-        juce::Colour cHi   = goldBright().withMultipliedBrightness (1.0f + 0.6f * glow);
-
-        juce::ColourGradient body (cMid,  cx, cy,
-                                   cDark, cx, cy - r, true);
-        body.addColour (0.15, cHi);
-        body.addColour (0.50, cDark);
-        body.addColour (0.85, cHi);
-        g.setGradientFill (body);
-        g.fillEllipse (cx - r, cy - r, r * 2.0f, r * 2.0f);
-
-        // Biseaux
-        g.setColour (goldEdge().withAlpha (0.55f + 0.3f * glow));
-        g.drawEllipse (cx - r, cy - r, r * 2.0f, r * 2.0f, 1.5f);
-        g.setColour (juce::Colours::black.withAlpha (0.35f));
-        g.drawEllipse (cx - r + 2.0f, cy - r + 2.0f, (r - 2.0f) * 2.0f, (r - 2.0f) * 2.0f, 1.0f);
+        const int frame = juce::roundToInt (intensity * (float) (numFrames - 1));
+        g.drawImage (bodyFrames,
+                     juce::roundToInt (cx - side * 0.5f), juce::roundToInt (cy - side * 0.5f), side, side,
+                     0, frame * bodyFrameSize, bodyFrameSize, bodyFrameSize);
+    }
+    else
+    {
+        drawBody (g, cx, cy, r, intensity);
     }
 
     // Piste passive
@@ -12,6 +12,18 @@ public:
     // 0..1 contrôle la brillance
     void setIntensity (float v) noexcept { intensity = juce::jlimit (0.0f, 1.0f, v); }
 
+    // Corps précalculé (ombre + dégradé + biseaux), une image par niveau de brillance
+    // empilée verticalement; sans images valides, le corps est dessiné en vectoriel
+    void setBodyFrames (juce::Image frames, int frameSizePx, float pixelScale)
+    {
+        bodyFrames = frames;
+        bodyFrameSize = frameSizePx;
+        bodyPixelScale = pixelScale;
+    }
+
+    // Corps seul, réutilisé pour le précalcul hors thread message
+    static void drawBody (juce::Graphics& g, float cx, float cy, float r, float glow);
+
     void drawRotarySlider (juce::Graphics& g, int x, int y, int w, int h,
                            float sliderPos, const float rotaryStart,
                            const float rotaryEnd, juce::Slider& s) override;
@@ -19,6 +31,10 @@ public:
 private:
     float intensity = 0.0f;
 
+    juce::Image bodyFrames;
+    int   bodyFrameSize  = 0;
+    float bodyPixelScale = 1.0f;
+
     // Palette dorée
     static juce::Colour goldDark()   noexcept { return juce::Colour::fromRGB (130, 98, 38); }
     static juce::Colour goldMid()    noexcept { return juce::Colour::fromRGB (212,170,70); }
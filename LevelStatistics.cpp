@@ -0,0 +1,239 @@
+//============================== LevelStatistics.cpp ===============================
+#include "LevelStatistics.h"
+#include <cmath>
+
+//==============================================================================
+int LevelHistogram::binFor (float db) noexcept
+{
+    const int b = (int) std::floor ((db - kMinDb) / kStepDb);
+    return juce::jlimit (0, kNumBins - 1, b);
+}
+
+void LevelHistogram::add (float db, juce::uint64 weight) noexcept
+{
+    bins[(size_t) binFor (db)] += weight;
+    total += weight;
+}
+
+void LevelHistogram::merge (const LevelHistogram& other) noexcept
+{
+    for (size_t i = 0; i < bins.size(); ++i)
+        bins[i] += other.bins[i];
+
+    total += other.total;
+}
+
+void LevelHistogram::clear() noexcept
+{
+    bins.fill (0);
+    total = 0;
+}
+
+juce::uint64 LevelHistogram::getWeightAbove (float db) const noexcept
+{
+    juce::uint64 sum = 0;
+    for (int i = binFor (db) + 1; i < kNumBins; ++i)
+        sum += bins[(size_t) i];
+
+    return sum;
+}
+
+float LevelHistogram::getQuantile (double q) const noexcept
+{
+    if (total == 0)
+        return kMinDb;
+
+    const auto rank = (juce::uint64) std::ceil (juce::jlimit (0.0, 1.0, q) * (double) total);
+    juce::uint64 sum = 0;
+
+    for (int i = 0; i < kNumBins; ++i)
+    {
+        sum += bins[(size_t) i];
+        if (sum >= juce::jmax ((juce::uint64) 1, rank))
+            return kMinDb + ((float) i + 0.5f) * kStepDb;
+    }
+
+    return kMaxDb;
+}
+
+void LevelHistogram::writeTo (juce::OutputStream& out) const
+{
+    // Format creux: (index, poids) des cases non vides
+    int used = 0;
+    for (auto b : bins)
+        used += b != 0 ? 1 : 0;
+
+    out.writeInt (used);
+    for (int i = 0; i < kNumBins; ++i)
+        if (bins[(size_t) i] != 0)
+        {
+            out.writeShort ((short) i);
+            out.writeInt64 ((juce::int64) bins[(size_t) i]);
+        }
+}
+
+bool LevelHistogram::readFrom (juce::InputStream& in)
+{
+    clear();
+
+    const int used = in.readInt();
+    if (! juce::isPositiveAndNotGreaterThan (used, kNumBins))
+        return false;
+
+    for (int n = 0; n < used; ++n)
+    {
+        const int i = in.readShort();
+        const auto w = (juce::uint64) in.readInt64();
+        if (! juce::isPositiveAndBelow (i, kNumBins))
+        {
+            clear();
+            return false;
+        }
+
+        bins[(size_t) i] += w;
+        total += w;
+    }
+
+    return true;
+}
+
+//==============================================================================
+const juce::Identifier LevelStatistics::stateType { "STATS" };
+
+LevelStatistics::LevelStatistics()
+{
+    thread->addTimeSliceClient (this);
+}
+
+LevelStatistics::~LevelStatistics()
+{
+    thread->removeTimeSliceClient (this);
+}
+
+void LevelStatistics::prepare (double sampleRate)
+{
+    sr.store (sampleRate > 0.0 ? sampleRate : 48000.0);
+    frameLength = juce::jmax (1, (int) std::round (sr.load() * 0.01));
+    frame = {};
+}
+
+//==============================================================================
+void LevelStatistics::push (float shortTermLufs, float peakDb, int numSamples) noexcept
+{
+    // Regroupement par trames de 10 ms: débit de la FIFO indépendant de la taille de bloc
+    frame.loudness    = shortTermLufs;
+    frame.peakDb      = frame.numSamples > 0 ? juce::jmax (frame.peakDb, peakDb) : peakDb;
+    frame.numSamples += numSamples;
+
+    if (frame.numSamples < frameLength)
+        return;
+
+    // FIFO pleine: la trame est perdue plutôt que de bloquer l'audio
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (1, start1, size1, start2, size2);
+    if (size1 > 0)
+        queue[(size_t) start1] = frame;
+
+    fifo.finishedWrite (size1);
+    frame = {};
+}
+
+int LevelStatistics::useTimeSlice()
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (fifo.getNumReady(), start1, size1, start2, size2);
+
+    if (size1 + size2 > 0)
+    {
+        const juce::ScopedLock sl (lock);
+
+        // Poids en microsecondes: indépendant de la fréquence d'échantillonnage
+        const double usPerSample = 1.0e6 / sr.load();
+
+        auto integrate = [this, usPerSample] (int start, int size)
+        {
+            for (int i = start; i < start + size; ++i)
+            {
+                const auto& o = queue[(size_t) i];
+                const auto w = (juce::uint64) std::llround (o.numSamples * usPerSample);
+
+                if (o.loudness >= kLoudnessGateLufs)
+                    histograms[shortTermLoudness].add (o.loudness, w);
+
+                histograms[peak].add (o.peakDb, w);
+            }
+        };
+
+        integrate (start1, size1);
+        integrate (start2, size2);
+    }
+
+    fifo.finishedRead (size1 + size2);
+    return 100;
+}
+
+//==============================================================================
+float LevelStatistics::getQuantile (Metric m, double q) const
+{
+    const juce::ScopedLock sl (lock);
+    return histograms[(size_t) m].getQuantile (q);
+}
+
+double LevelStatistics::getSecondsAbove (Metric m, float thresholdDb) const
+{
+    const juce::ScopedLock sl (lock);
+    return (double) histograms[(size_t) m].getWeightAbove (thresholdDb) * 1.0e-6;
+}
+
+double LevelStatistics::getSeconds (Metric m) const
+{
+    const juce::ScopedLock sl (lock);
+    return (double) histograms[(size_t) m].getTotalWeight() * 1.0e-6;
+}
+
+LevelHistogram LevelStatistics::getHistogram (Metric m) const
+{
+    const juce::ScopedLock sl (lock);
+    return histograms[(size_t) m];
+}
+
+void LevelStatistics::reset()
+{
+    const juce::ScopedLock sl (lock);
+    for (auto& h : histograms)
+        h.clear();
+}
+
+//==============================================================================
+juce::ValueTree LevelStatistics::toValueTree() const
+{
+    juce::MemoryOutputStream out;
+    {
+        const juce::ScopedLock sl (lock);
+        for (auto& h : histograms)
+            h.writeTo (out);
+    }
+
+    juce::ValueTree tree (stateType);
+    tree.setProperty ("histograms", out.getMemoryBlock().toBase64Encoding(), nullptr);
+    return tree;
+}
+
+void LevelStatistics::fromValueTree (const juce::ValueTree& tree)
+{
+    if (! tree.hasType (stateType))
+        return;
+
+    juce::MemoryBlock data;
+    if (! data.fromBase64Encoding (tree.getProperty ("histograms").toString()))
+        return;
+
+    juce::MemoryInputStream in (data, false);
+    std::array<LevelHistogram, numMetrics> loaded;
+    for (auto& h : loaded)
+        if (! h.readFrom (in))
+            return;
+
+    const juce::ScopedLock sl (lock);
+    histograms = loaded;
+}
@@ -0,0 +1,113 @@
+//============================== LevelStatistics.h ===============================
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ * Histogramme de niveaux à pas fixe (0.1 dB sur -100..+10 dB), pondéré par
+ * la durée (microsecondes). Sert aussi d'esquisse de quantiles: erreur bornée
+ * à un demi-pas, mémoire constante, fusion par simple addition.
+ */
+class LevelHistogram
+{
+public:
+    static constexpr float kMinDb   = -100.0f;
+    static constexpr float kMaxDb   = 10.0f;
+    static constexpr float kStepDb  = 0.1f;
+    static constexpr int   kNumBins = 1100;
+
+    void add (float db, juce::uint64 weight) noexcept;
+    void merge (const LevelHistogram&) noexcept;
+    void clear() noexcept;
+
+    juce::uint64 getTotalWeight() const noexcept        { return total; }
+    juce::uint64 getWeightAbove (float db) const noexcept;
+
+    // Quantile q (0..1) en dB, kMinDb si vide
+    float getQuantile (double q) const noexcept;
+
+    void writeTo (juce::OutputStream&) const;
+    bool readFrom (juce::InputStream&);
+
+private:
+    static int binFor (float db) noexcept;
+
+    std::array<juce::uint64, kNumBins> bins {};
+    juce::uint64 total = 0;
+};
+
+//==============================================================================
+/**
+ * Statistiques de niveau longue durée (sonie court terme, crête).
+ *
+ * Le thread audio regroupe ses mesures par trames de 10 ms et les pousse dans
+ * une FIFO sans verrou; un TimeSliceThread partagé par toutes les instances
+ * les intègre aux histogrammes. Mémoire indépendante de la durée de session.
+ */
+class LevelStatistics : private juce::TimeSliceClient
+{
+public:
+    enum Metric
+    {
+        shortTermLoudness = 0,
+        peak,
+        numMetrics
+    };
+
+    // Porte absolue BS.1770: les silences ne faussent pas la distribution de sonie
+    static constexpr float kLoudnessGateLufs = -70.0f;
+
+    LevelStatistics();
+    ~LevelStatistics() override;
+
+    void prepare (double sampleRate);
+
+    // Thread audio
+    void push (float shortTermLufs, float peakDb, int numSamples) noexcept;
+
+    // Threads non audio
+    float  getQuantile (Metric, double q) const;
+    double getSecondsAbove (Metric, float thresholdDb) const;
+    double getSeconds (Metric) const;
+    LevelHistogram getHistogram (Metric) const;
+    void   reset();
+
+    // Persistance (enfant "STATS" de l'état)
+    juce::ValueTree toValueTree() const;
+    void fromValueTree (const juce::ValueTree&);
+
+    static const juce::Identifier stateType;
+
+private:
+    struct Observation
+    {
+        float loudness = -120.0f;
+        float peakDb   = -120.0f;
+        int   numSamples = 0;
+    };
+
+    struct SharedThread : public juce::TimeSliceThread
+    {
+        SharedThread() : juce::TimeSliceThread ("Spectra Level Statistics") { startThread(); }
+        ~SharedThread() override { stopThread (2000); }
+    };
+
+    int useTimeSlice() override;
+
+    static constexpr int kQueueSize = 1024;
+    juce::AbstractFifo fifo { kQueueSize };
+    std::array<Observation, kQueueSize> queue;
+
+    // Trame audio en cours (thread audio uniquement)
+    Observation frame;
+    int frameLength = 480;
+
+    // Histogrammes (thread statistiques + message)
+    juce::CriticalSection lock;
+    std::array<LevelHistogram, numMetrics> histograms;
+    std::atomic<double> sr { 48000.0 };
+
+    juce::SharedResourcePointer<SharedThread> thread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelStatistics)
+};
@@ -0,0 +1,87 @@
+//============================== LoudnessMeter.cpp ===============================
+#include "LoudnessMeter.h"
+#include <cmath>
+
+//==============================================================================
+void LoudnessMeter::prepare (double sampleRate)
+{
+    const double fs = sampleRate > 0.0 ? sampleRate : 48000.0;
+    const double pi = juce::MathConstants<double>::pi;
+
+    // Pondération K: coefficients BS.1770 recalculés pour toute fréquence d'échantillonnage
+    {
+        const double f0 = 1681.974450955533;
+        const double G  = 3.999843853973347;
+        const double Q  = 0.7071752369554196;
+        const double K  = std::tan (pi * f0 / fs);
+        const double Vh = std::pow (10.0, G / 20.0);
+        const double Vb = std::pow (Vh, 0.4996667741545416);
+        const double a0 = 1.0 + K / Q + K * K;
+
+        shelf.b0 = (Vh + Vb * K / Q + K * K) / a0;
+        shelf.b1 = 2.0 * (K * K - Vh) / a0;
+        shelf.b2 = (Vh - Vb * K / Q + K * K) / a0;
+        shelf.a1 = 2.0 * (K * K - 1.0) / a0;
+        shelf.a2 = (1.0 - K / Q + K * K) / a0;
+    }
+    {
+        const double f0 = 38.13547087602444;
+        const double Q  = 0.5003270373238773;
+        const double K  = std::tan (pi * f0 / fs);
+        const double a0 = 1.0 + K / Q + K * K;
+
+        highPass.b0 = 1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 = 1.0;
+        highPass.a1 = 2.0 * (K * K - 1.0) / a0;
+        highPass.a2 = (1.0 - K / Q + K * K) / a0;
+    }
+
+    binLength = juce::jmax (1, (int) std::round (fs * 0.1));
+    reset();
+}
+
+void LoudnessMeter::reset() noexcept
+{
+    for (auto& z : state)
+        z.fill (0.0);
+
+    bins.fill (0.0);
+    binPos = binIndex = binsFilled = 0;
+    binSum = 0.0;
+
+    momentary.store (kSilenceLufs, std::memory_order_relaxed);
+    shortTerm.store (kSilenceLufs, std::memory_order_relaxed);
+}
+
+//==============================================================================
+float LoudnessMeter::toLufs (double meanSquare) noexcept
+{
+    if (meanSquare <= 1.0e-12)
+        return kSilenceLufs;
+
+    return juce::jmax (kSilenceLufs, (float) (-0.691 + 10.0 * std::log10 (meanSquare)));
+}
+
+void LoudnessMeter::closeBin() noexcept
+{
+    bins[(size_t) binIndex] = binSum;
+    binIndex   = (binIndex + 1) % kBinsShortTerm;
+    binsFilled = juce::jmin (binsFilled + 1, kBinsShortTerm);
+    binSum = 0.0;
+    binPos = 0;
+
+    // Sommes des cases les plus récentes (fenêtres incomplètes au démarrage)
+    double sumM = 0.0, sumS = 0.0;
+    for (int k = 0; k < binsFilled; ++k)
+    {
+        const double v = bins[(size_t) ((binIndex - 1 - k + kBinsShortTerm) % kBinsShortTerm)];
+        sumS += v;
+        if (k < kBinsMomentary)
+            sumM += v;
+    }
+
+    const double len = (double) binLength;
+    momentary.store (toLufs (sumM / (len * juce::jmin (binsFilled, kBinsMomentary))), std::memory_order_relaxed);
+    shortTerm.store (toLufs (sumS / (len * binsFilled)), std::memory_order_relaxed);
+}
@@ -0,0 +1,94 @@
+//============================== LoudnessMeter.h ===============================
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ * Sonie ITU-R BS.1770 (pondération K), canaux L/R de poids 1.
+ * Momentanée (400 ms) et court terme (3 s) glissantes par cases de 100 ms.
+ * Aucune allocation après prepare(); lecture des valeurs depuis tout thread.
+ */
+class LoudnessMeter
+{
+public:
+    static constexpr int   kMaxChannels = 2;
+    static constexpr float kSilenceLufs = -120.0f;
+
+    void prepare (double sampleRate);
+    void reset() noexcept;
+
+    // Thread audio
+    template <typename Sample>
+    void process (const Sample* const* channels, int numChannels, int numSamples) noexcept;
+
+    float getMomentaryLufs() const noexcept  { return momentary.load (std::memory_order_relaxed); }
+    float getShortTermLufs() const noexcept  { return shortTerm.load (std::memory_order_relaxed); }
+
+private:
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    static constexpr int kBinsShortTerm = 30;   // 30 × 100 ms
+    static constexpr int kBinsMomentary = 4;    //  4 × 100 ms
+
+    void   closeBin() noexcept;
+    static float toLufs (double meanSquare) noexcept;
+
+    Biquad shelf, highPass;
+    std::array<std::array<double, 4>, kMaxChannels> state {};   // z1/z2 par étage
+
+    int    binLength = 4800, binPos = 0, binIndex = 0, binsFilled = 0;
+    double binSum = 0.0;
+    std::array<double, kBinsShortTerm> bins {};
+
+    std::atomic<float> momentary { kSilenceLufs };
+    std::atomic<float> shortTerm { kSilenceLufs };
+};
+
+//==============================================================================
+template <typename Sample>
+void LoudnessMeter::process (const Sample* const* channels, int numChannels, int numSamples) noexcept
+{
+    numChannels = juce::jmin (numChannels, kMaxChannels);
+
+    int done = 0;
+    while (done < numSamples)
+    {
+        // Découpage aux frontières de cases de 100 ms
+        const int n = juce::jmin (numSamples - done, binLength - binPos);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const Sample* x = channels[ch] + done;
+            auto& z = state[(size_t) ch];
+            double acc = 0.0;
+
+            for (int i = 0; i < n; ++i)
+            {
+                // Étage 1: plateau haut (DF2 transposée)
+                const double in = (double) x[i];
+                const double y1 = shelf.b0 * in + z[0];
+                z[0] = shelf.b1 * in - shelf.a1 * y1 + z[1];
+                z[1] = shelf.b2 * in - shelf.a2 * y1;
+
+                // Étage 2: passe-haut RLB
+                const double y2 = highPass.b0 * y1 + z[2];
+                z[2] = highPass.b1 * y1 - highPass.a1 * y2 + z[3];
+                z[3] = highPass.b2 * y1 - highPass.a2 * y2;
+
+                acc += y2 * y2;
+            }
+
+            binSum += acc;
+        }
+
+        binPos += n;
+        done   += n;
+
+        if (binPos >= binLength)
+            closeBin();
+    }
+}
@@ -1,5 +1,6 @@
 //============================== MainComponent.cpp ============================
 #include "MainComponent.h"
+#include "RealtimeGuard.h"
 #include <cmath>
 
 //=============================================================================
@@ -60,6 +61,7 @@ MainComponent::MainComponent()
     gain.onValueChange = [this]
     {
         const float v = (float) gain.getValue();
+        gainValue.store (v);
         const auto s = juce::String (v, 2);
         gainReadout.setText (s, juce::dontSendNotification);
         gainReadoutRight.setText (s, juce::dontSendNotification);
@@ -102,45 +104,31 @@ MainComponent::~MainComponent() { shutdownAudio(); }
 void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
 {
     juce::ignoreUnused (samplesPerBlockExpected);
-    sr = sampleRate > 0.0 ? sampleRate : 48000.0;
+    inMeter .prepare (sampleRate);
+    outMeter.prepare (sampleRate);
 }
 
 //=============================================================================
+// Aucun appel Slider/Component ici: l'UI lit les niveaux dans timerCallback()
 void MainComponent::getNextAudioBlock (const juce::AudioSourceChannelInfo& info)
 {
+    SPECTRA_RT_SCOPE;
+
     auto* buffer = info.buffer;
     const int n = info.numSamples;
 
     auto* in  = buffer->getReadPointer  (juce::jmin (0, buffer->getNumChannels()-1), info.startSample);
     auto* out = buffer->getWritePointer (juce::jmin (0, buffer->getNumChannels()-1), info.startSample);
 
-    const float g = (float) gain.getValue();
-    float accIn = 0.0f, accOut = 0.0f;
-
-    for (int i = 0; i < n; ++i)
-    {
-        const float x = in[i];
-        const float y = x * g;
-        out[i] = y;
-        accIn  += std::abs (x);
-        accOut += std::abs (y);
-    }
+    const float g = gainValue.load();
 
-    const float targetIn  = juce::jlimit (0.0f, 1.0f, accIn  / (float) n);
-    const float targetOut = juce::jlimit (0.0f, 1.0f, accOut / (float) n);
+    inMeter.process (&in, 1, n);
 
-    const float aUp   = 1.0f - std::exp (-meterAttack  * (float) n / (float) sr);
-    const float aDown = 1.0f - std::exp (-meterRelease * (float) n / (float) sr);
-
-    auto lerp = [] (float a, float b, float t) noexcept { return a + t * (b - a); };
-
-    inLevel  = targetIn  > inLevel  ? lerp (inLevel,  targetIn,  aUp)
-                                    : lerp (inLevel,  targetIn,  aDown);
-    outLevel = targetOut > outLevel ? lerp (outLevel, targetOut, aUp)
-                                    : lerp (outLevel, targetOut, aDown);
+    for (int i = 0; i < n; ++i)
+        out[i] = in[i] * g;
 
-    meterIn.setLevel  (inLevel);
-    meterOut.setLevel (outLevel);
+    const float* processed = out;
+    outMeter.process (&processed, 1, n);
 }
 
 //=============================================================================
@@ -185,5 +173,7 @@ void MainComponent::resized()
 void MainComponent::timerCallback()
 {
     const float s = uiScaleFor (*this);
+    meterIn.setLevel  (inMeter.getLevel());
+    meterOut.setLevel (outMeter.getLevel());
     repaint (juce::Rectangle<int> (0, SX (s, 340), getWidth(), SX (s, 80)));
 }
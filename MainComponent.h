@@ -1,6 +1,7 @@
 //============================== MainComponent.h ===============================
 #pragma once
 #include <JuceHeader.h>
+#include "MeterBallistics.h"
 
 //=============================================================================
 // Barre de niveau linéaire 0..1
@@ -72,12 +73,9 @@ private:
     juce::Label  titleRight { "titleRight", "Audio Unit" };
     LinearMeter  meterIn, meterOut;
 
-    // État audio/mètres
-    float  inLevel      = 0.0f;
-    float  outLevel     = 0.0f;
-    float  meterAttack  = 0.25f;
-    float  meterRelease = 0.04f;
-    double sr           = 48000.0;
+    // État audio/mètres (écrits par l'audio, lus par le timer UI)
+    std::atomic<float> gainValue { 0.50f };
+    MeterBallistics    inMeter, outMeter;     // même balistique que le plugin
 
     // Timer
     void timerCallback() override;
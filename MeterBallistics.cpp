@@ -0,0 +1,57 @@
+//============================== MeterBallistics.cpp ===============================
+#include "MeterBallistics.h"
+#include <cmath>
+
+//==============================================================================
+namespace
+{
+    // Pôle simple de constante de temps tau (s)
+    float onePole (double tauSeconds, double sr)
+    {
+        return (float) (1.0 - std::exp (-1.0 / juce::jmax (1.0e-9, tauSeconds * sr)));
+    }
+
+    // Retour: chute de 'db' dB en 'seconds' (linéaire en dB)
+    float fallback (double db, double seconds, double sr)
+    {
+        return (float) (1.0 - std::pow (10.0, -db / (20.0 * seconds * sr)));
+    }
+}
+
+//==============================================================================
+void MeterBallistics::prepare (double sampleRate)
+{
+    const double sr = sampleRate > 0.0 ? sampleRate : 48000.0;
+
+    auto& peak = coeffs[(size_t) Mode::digitalPeak];
+    peak.attack  = 1.0f;
+    peak.release = fallback (20.0, 1.7, sr);
+
+    // Constantes de montée calées sur une salve de 5 kHz redressée: une salve
+    // de la durée d'intégration (5 / 10 ms) lit 2 dB sous le régime établi
+    auto& type1 = coeffs[(size_t) Mode::ppmTypeI];
+    type1.attack  = onePole (0.00125, sr);
+    type1.release = fallback (20.0, 1.7, sr);
+
+    auto& type2 = coeffs[(size_t) Mode::ppmTypeII];
+    type2.attack  = onePole (0.0025, sr);
+    type2.release = fallback (24.0, 2.8, sr);
+
+    // VU: second ordre à amortissement critique, 99 % atteint en 300 ms
+    // (1 - e^-t (1 + t) = 0.99 pour t = 6.638 constantes de temps)
+    const float vuPole = onePole (0.300 / 6.638, sr);
+    auto& vu = coeffs[(size_t) Mode::vu];
+    vu.attack        = vuPole;
+    vu.release       = vuPole;
+    vu.releaseTarget = 1.0f;
+    vu.smooth        = vuPole;
+
+    reset();
+}
+
+void MeterBallistics::reset() noexcept
+{
+    stage1.fill (0.0f);
+    stage2.fill (0.0f);
+    level.store (0.0f, std::memory_order_relaxed);
+}
@@ -0,0 +1,98 @@
+//============================== MeterBallistics.h ===============================
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ * Balistique de mètre normalisée, calculée échantillon par échantillon.
+ *
+ * Détecteur à deux étages sur le signal redressé, un canal par voie (kLanes
+ * voies en parallèle, boucle interne à largeur fixe vectorisable):
+ *   - étage 1: montée à constante d'intégration, retour exponentiel
+ *     (chute linéaire en dB pour les crêtemètres, symétrique pour le VU);
+ *   - étage 2: second pôle du VU (amortissement critique), transparent sinon.
+ * Les coefficients des quatre modes sont précalculés dans prepare(): la lecture
+ * ne dépend ni de la taille de bloc ni de la fréquence d'échantillonnage.
+ */
+class MeterBallistics
+{
+public:
+    enum class Mode
+    {
+        digitalPeak = 0,    // IEC 60268-18: montée instantanée, retour 20 dB / 1.7 s
+        ppmTypeI,           // IEC 60268-10 type I (DIN): intégration 5 ms, retour 20 dB / 1.7 s
+        ppmTypeII,          // IEC 60268-10 type II (BBC/EBU): intégration 10 ms, retour 24 dB / 2.8 s
+        vu                  // IEC 60268-17: 300 ms jusqu'à 99 %, montée = descente (moyenne redressée)
+    };
+
+    static constexpr int kNumModes = 4;
+    static constexpr int kLanes    = 8;
+
+    void prepare (double sampleRate);
+    void reset() noexcept;
+
+    // Thread audio: sélection parmi les coefficients précalculés (sans calcul)
+    void setMode (Mode m) noexcept              { mode = m; }
+    Mode getMode() const noexcept               { return mode; }
+
+    // Thread audio
+    template <typename Sample>
+    void process (const Sample* const* channels, int numChannels, int numSamples) noexcept;
+
+    // Niveau affiché (amplitude linéaire, max des canaux); lisible depuis tout thread
+    float getLevel() const noexcept             { return level.load (std::memory_order_relaxed); }
+
+private:
+    struct Coefficients
+    {
+        float attack    = 1.0f;     // étage 1, montée: y += attack * (x - y)
+        float release   = 0.0f;     // étage 1, retour: y += release * (x * releaseTarget - y)
+        float releaseTarget = 0.0f; // 0 = chute exponentielle (crête), 1 = suit le signal (VU)
+        float smooth    = 1.0f;     // étage 2: z += smooth * (y - z)
+    };
+
+    std::array<Coefficients, kNumModes> coeffs {};
+    Mode mode = Mode::digitalPeak;
+
+    alignas (32) std::array<float, kLanes> stage1 {};
+    alignas (32) std::array<float, kLanes> stage2 {};
+
+    std::atomic<float> level { 0.0f };
+};
+
+//==============================================================================
+template <typename Sample>
+void MeterBallistics::process (const Sample* const* channels, int numChannels, int numSamples) noexcept
+{
+    numChannels = juce::jmin (numChannels, kLanes);
+    const auto c = coeffs[(size_t) mode];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        alignas (32) float x[kLanes] = {};
+        for (int k = 0; k < numChannels; ++k)
+            x[k] = std::abs ((float) channels[k][i]);
+
+        for (int k = 0; k < kLanes; ++k)
+        {
+            float y = stage1[(size_t) k];
+            y = x[k] > y ? y + c.attack  * (x[k] - y)
+                         : y + c.release * (x[k] * c.releaseTarget - y);
+
+            stage1[(size_t) k] = y;
+            stage2[(size_t) k] += c.smooth * (y - stage2[(size_t) k]);
+        }
+    }
+
+    // Extinction franche: évite les dénormaux en fin de décroissance
+    float peak = 0.0f;
+    for (int k = 0; k < kLanes; ++k)
+    {
+        if (stage1[(size_t) k] < 1.0e-9f) stage1[(size_t) k] = 0.0f;
+        if (stage2[(size_t) k] < 1.0e-9f) stage2[(size_t) k] = 0.0f;
+        peak = juce::jmax (peak, stage2[(size_t) k]);
+    }
+
+    level.store (peak, std::memory_order_relaxed);
+}
@@ -0,0 +1,83 @@
+//============================== OutputDither.cpp ===============================
+#include "OutputDither.h"
+
+//==============================================================================
+namespace
+{
+    // NTF(z) = 1 - Σ c[k] z^-(k+1)
+    const float firstOrderCoeffs[] = { 1.0f };
+    const float eWeightedCoeffs[]  = { 1.623f, -0.982f, 0.109f };
+    const float fWeightedCoeffs[]  = { 2.412f, -3.370f, 3.937f, -4.174f, 3.353f, -2.205f, 1.281f, -0.569f, 0.0847f };
+}
+
+int OutputDither::numCoefficients (Shape s) noexcept
+{
+    switch (s)
+    {
+        case Shape::firstOrder: return 1;
+        case Shape::eWeighted:  return 3;
+        case Shape::fWeighted:  return 9;
+        case Shape::tpdf:       break;
+    }
+
+    return 0;
+}
+
+const float* OutputDither::coefficients (Shape s) noexcept
+{
+    switch (s)
+    {
+        case Shape::firstOrder: return firstOrderCoeffs;
+        case Shape::eWeighted:  return eWeightedCoeffs;
+        case Shape::fWeighted:  return fWeightedCoeffs;
+        case Shape::tpdf:       break;
+    }
+
+    return nullptr;
+}
+
+//==============================================================================
+void OutputDither::prepare (int maxBlockSize)
+{
+    maxBlock = juce::jmax (32, maxBlockSize);
+    noise.assign ((size_t) maxBlock, 0.0f);
+    reset();
+}
+
+void OutputDither::reset() noexcept
+{
+    // Position remise à zéro: un rendu hors ligne redémarre la même séquence
+    position = 0;
+    for (auto& e : errors)
+        e.fill (0.0f);
+}
+
+void OutputDither::generateTpdf (float* dest, int channel, juce::uint64 pos, int numSamples) const noexcept
+{
+    constexpr float toUnit = 1.0f / 16777216.0f;   // 2^-24
+
+    int done = 0;
+    while (done < numSamples)
+    {
+        // Clé de flux: graine, canal et moitié haute de la position
+        const auto p   = pos + (juce::uint64) done;
+        const auto low = (juce::uint32) p;
+        const juce::uint32 key1 = hash (seed ^ hash ((juce::uint32) (p >> 32) + 0x9e3779b9u * (juce::uint32) (channel + 1)));
+        const juce::uint32 key2 = hash (key1 + 0x85ebca6bu);
+
+        // Découpage au passage de la moitié basse par 2^32
+        const auto untilWrap = (juce::uint64) 0x100000000ull - low;
+        const int  n = (int) juce::jmin ((juce::uint64) (numSamples - done), untilWrap);
+
+        float* out = dest + done;
+        for (int i = 0; i < n; ++i)
+        {
+            const juce::uint32 c = low + (juce::uint32) i;
+            const float u1 = (float) (hash (c ^ key1) >> 8) * toUnit;
+            const float u2 = (float) (hash (c ^ key2) >> 8) * toUnit;
+            out[i] = u1 - u2;
+        }
+
+        done += n;
+    }
+}
@@ -0,0 +1,147 @@
+//============================== OutputDither.h ===============================
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+/**
+ * Réduction de longueur de mot en sortie: dither TPDF + mise en forme du bruit.
+ *
+ * Le bruit vient d'un générateur à compteur (hachage de la position
+ * d'échantillon, de la graine et du canal): sans état séquentiel, il se calcule
+ * par blocs vectorisés et un rendu hors ligne est reproductible quelle que soit
+ * la taille de bloc. La boucle de quantification n'est récursive que si un
+ * filtre de mise en forme est actif. La position avance aussi dither coupé
+ * (skip): le bruit reste attaché à la timeline malgré l'automation.
+ */
+class OutputDither
+{
+public:
+    enum class Shape
+    {
+        tpdf = 0,       // bruit blanc TPDF, sans mise en forme
+        firstOrder,     // NTF = 1 - z^-1
+        eWeighted,      // 3 coefficients (Wannamaker), optimisés pour 44.1 kHz
+        fWeighted       // 9 coefficients (Wannamaker), optimisés pour 44.1 kHz
+    };
+
+    static constexpr int          kMaxChannels = 8;
+    static constexpr int          kMaxOrder    = 9;
+    static constexpr juce::uint32 kDefaultSeed = 0x5EC7A001u;
+
+    void prepare (int maxBlockSize);
+    void reset() noexcept;
+
+    // Thread quelconque: graine appliquée au début du bloc suivant
+    void setSeed (juce::uint32 newSeed) noexcept    { requestedSeed.store (newSeed, std::memory_order_relaxed); }
+
+    // Thread audio: quantifie 'buffer' sur 'bits' bits (8..24)
+    template <typename Sample>
+    void process (juce::AudioBuffer<Sample>& buffer, int bits, Shape) noexcept;
+
+    // Thread audio: bloc non traité (dither coupé), position avancée quand même
+    void skip (int numSamples) noexcept
+    {
+        seed = requestedSeed.load (std::memory_order_relaxed);
+        position += (juce::uint64) juce::jmax (0, numSamples);
+    }
+
+    // Bruit TPDF (±1 LSB crête, en LSB) pour les positions [position, position + n)
+    void generateTpdf (float* dest, int channel, juce::uint64 position, int numSamples) const noexcept;
+
+private:
+    static juce::uint32 hash (juce::uint32 x) noexcept
+    {
+        // lowbias32 (C. Wellons): mélange complet sur 32 bits
+        x ^= x >> 16;  x *= 0x7feb352du;
+        x ^= x >> 15;  x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    static int numCoefficients (Shape) noexcept;
+    static const float* coefficients (Shape) noexcept;
+
+    int maxBlock = 512;
+    std::vector<float> noise;
+    std::array<std::array<float, kMaxOrder>, kMaxChannels> errors {};
+    juce::uint64 position = 0;
+    juce::uint32 seed = kDefaultSeed;                               // copie du thread audio
+    std::atomic<juce::uint32> requestedSeed { kDefaultSeed };
+    Shape lastShape = Shape::tpdf;
+};
+
+//==============================================================================
+template <typename Sample>
+void OutputDither::process (juce::AudioBuffer<Sample>& buffer, int bits, Shape shape) noexcept
+{
+    const int numSamples  = buffer.getNumSamples();
+    const int numChannels = juce::jmin (buffer.getNumChannels(), kMaxChannels);
+
+    seed = requestedSeed.load (std::memory_order_relaxed);
+
+    // Changement de filtre: historique d'erreur remis à zéro
+    if (shape != lastShape)
+    {
+        for (auto& e : errors)
+            e.fill (0.0f);
+
+        lastShape = shape;
+    }
+
+    // Quantification en double: en float, x * 2^23 + d perd la partie
+    // fractionnaire du dither à 24 bits
+    const double scale = (double) (1 << (juce::jlimit (8, 24, bits) - 1));
+    const double lsb   = 1.0 / scale;
+    const double lo    = -1.0;
+    const double hi    = 1.0 - lsb;
+
+    const int    order = numCoefficients (shape);
+    const float* c     = coefficients (shape);
+
+    for (int done = 0; done < numSamples; done += maxBlock)
+    {
+        const int n = juce::jmin (maxBlock, numSamples - done);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            generateTpdf (noise.data(), ch, position + (juce::uint64) done, n);
+            auto* x = buffer.getWritePointer (ch, done);
+            const float* d = noise.data();
+
+            if (order == 0)
+            {
+                // Sans rétroaction: boucle entièrement vectorisable
+                for (int i = 0; i < n; ++i)
+                {
+                    const double q = std::floor ((double) x[i] * scale + (double) d[i] + 0.5) * lsb;
+                    x[i] = (Sample) juce::jlimit (lo, hi, q);
+                }
+            }
+            else
+            {
+                auto& e = errors[(size_t) ch];
+
+                for (int i = 0; i < n; ++i)
+                {
+                    double fb = 0;
+                    for (int k = 0; k < order; ++k)
+                        fb += (double) c[k] * (double) e[(size_t) k];
+
+                    const double v = (double) x[i] - fb;
+                    const double q = juce::jlimit (lo, hi, std::floor (v * scale + (double) d[i] + 0.5) * lsb);
+
+                    for (int k = order - 1; k > 0; --k)
+                        e[(size_t) k] = e[(size_t) (k - 1)];
+
+                    // Erreur bornée: un écrêtage ne doit pas faire diverger la boucle
+                    e[0] = (float) juce::jlimit (-4 * lsb, 4 * lsb, q - v);
+                    x[i] = (Sample) q;
+                }
+            }
+        }
+    }
+
+    position += (juce::uint64) numSamples;
+}
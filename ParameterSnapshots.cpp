@@ -0,0 +1,253 @@
+//============================== ParameterSnapshots.cpp ===============================
+#include "ParameterSnapshots.h"
+
+const juce::Identifier SnapshotBank::stateType { "SNAPSHOTS" };
+
+//==============================================================================
+SnapshotBank::SnapshotBank (juce::AudioProcessorValueTreeState& s)
+    : state (s)
+{
+    // Ordre figé: celui des paramètres du processeur
+    for (auto* p : state.processor.getParameters())
+    {
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (p))
+        {
+            jassert (numParams < kMaxParams);
+            if (numParams == kMaxParams)
+                break;
+
+            params[(size_t) numParams] = ranged;
+            raw   [(size_t) numParams] = state.getRawParameterValue (ranged->getParameterID());
+            ++numParams;
+        }
+    }
+
+    for (int i = 0; i < kNumSlots; ++i)
+        names[(size_t) i] = "Snapshot " + juce::String (i + 1);
+
+    start.numParams = current.numParams = numParams;
+}
+
+int SnapshotBank::indexOf (const juce::String& parameterID) const noexcept
+{
+    for (int i = 0; i < numParams; ++i)
+        if (params[(size_t) i]->getParameterID() == parameterID)
+            return i;
+
+    return -1;
+}
+
+//==============================================================================
+SnapshotBank::Snapshot* SnapshotBank::acquireFreeEntry() noexcept
+{
+    // Lire 'pending' avant 'audioTarget': l'audio publie sa cible avant de vider 'pending'
+    const Snapshot* inPending = pending.load();
+    const Snapshot* inAudio   = audioTarget.load();
+
+    for (auto& entry : pool)
+    {
+        if (&entry == inPending || &entry == inAudio)
+            continue;
+
+        if (std::find (slots.begin(), slots.end(), &entry) == slots.end())
+            return &entry;
+    }
+
+    jassertfalse; // impossible: kPoolSize > kNumSlots + 2
+    return nullptr;
+}
+
+void SnapshotBank::captureInto (Snapshot& dest) const
+{
+    dest.numParams = numParams;
+    for (int i = 0; i < numParams; ++i)
+    {
+        auto* p = params[(size_t) i];
+        dest.values[(size_t) i] = p->convertFrom0to1 (p->getValue());
+    }
+}
+
+void SnapshotBank::capture (int slot)
+{
+    if (! juce::isPositiveAndBelow (slot, kNumSlots))
+        return;
+
+    if (auto* entry = acquireFreeEntry())
+    {
+        captureInto (*entry);
+        slots[(size_t) slot] = entry;
+        currentSlot = slot;
+    }
+}
+
+bool SnapshotBank::recall (int slot)
+{
+    if (! hasSnapshot (slot))
+        return false;
+
+    auto* snap = slots[(size_t) slot];
+    currentSlot = slot;
+
+    // Publication pour l'audio d'abord (le morphing part des valeurs d'avant le
+    // rappel), puis mise à jour des paramètres hôte/UI. L'audio garde la cible
+    // tant que 'hostApplied' ne la désigne pas: jamais de mélange de valeurs
+    // brutes anciennes et nouvelles.
+    hostApplied.store (nullptr);
+    pending.store (snap);
+
+    for (int i = 0; i < numParams; ++i)
+    {
+        auto* p = params[(size_t) i];
+        p->setValueNotifyingHost (p->convertTo0to1 (snap->values[(size_t) i]));
+    }
+
+    hostApplied.store (snap);
+    return true;
+}
+
+bool SnapshotBank::hasSnapshot (int slot) const noexcept
+{
+    return juce::isPositiveAndBelow (slot, kNumSlots) && slots[(size_t) slot] != nullptr;
+}
+
+juce::String SnapshotBank::getSlotName (int slot) const
+{
+    return juce::isPositiveAndBelow (slot, kNumSlots) ? names[(size_t) slot] : juce::String();
+}
+
+void SnapshotBank::setSlotName (int slot, const juce::String& name)
+{
+    if (juce::isPositiveAndBelow (slot, kNumSlots))
+        names[(size_t) slot] = name;
+}
+
+//==============================================================================
+juce::ValueTree SnapshotBank::toValueTree() const
+{
+    juce::ValueTree tree (stateType);
+    tree.setProperty ("current", currentSlot.load(), nullptr);
+    tree.setProperty ("morph", getMorphTime(), nullptr);
+
+    for (int i = 0; i < kNumSlots; ++i)
+    {
+        juce::ValueTree slot ("SLOT");
+        slot.setProperty ("index", i, nullptr);
+        slot.setProperty ("name", names[(size_t) i], nullptr);
+
+        if (auto* snap = slots[(size_t) i])
+            for (int p = 0; p < numParams; ++p)
+            {
+                juce::ValueTree param ("PARAM");
+                param.setProperty ("id", params[(size_t) p]->getParameterID(), nullptr);
+                param.setProperty ("value", snap->values[(size_t) p], nullptr);
+                slot.appendChild (param, nullptr);
+            }
+
+        tree.appendChild (slot, nullptr);
+    }
+
+    return tree;
+}
+
+void SnapshotBank::fromValueTree (const juce::ValueTree& tree)
+{
+    if (! tree.hasType (stateType))
+        return;
+
+    setMorphTime ((double) tree.getProperty ("morph", 0.0));
+
+    for (auto slot : tree)
+    {
+        const int index = slot.getProperty ("index", -1);
+        if (! juce::isPositiveAndBelow (index, kNumSlots))
+            continue;
+
+        names[(size_t) index] = slot.getProperty ("name", names[(size_t) index]).toString();
+        slots[(size_t) index] = nullptr;
+
+        if (slot.getNumChildren() == 0)
+            continue;
+
+        if (auto* entry = acquireFreeEntry())
+        {
+            // Paramètres absents de l'état: valeur par défaut
+            entry->numParams = numParams;
+            for (int p = 0; p < numParams; ++p)
+                entry->values[(size_t) p] = params[(size_t) p]->convertFrom0to1 (params[(size_t) p]->getDefaultValue());
+
+            for (auto param : slot)
+            {
+                const int p = indexOf (param.getProperty ("id").toString());
+                if (p >= 0)
+                    entry->values[(size_t) p] = (float) param.getProperty ("value");
+            }
+
+            slots[(size_t) index] = entry;
+        }
+    }
+
+    currentSlot = juce::jlimit (0, kNumSlots - 1, (int) tree.getProperty ("current", 0));
+}
+
+//==============================================================================
+void SnapshotBank::prepare (double sampleRate) noexcept
+{
+    sr = sampleRate > 0.0 ? sampleRate : 48000.0;
+    target = nullptr;
+    morphPos = morphLength = 0;
+    audioTarget.store (nullptr);
+
+    for (int i = 0; i < numParams; ++i)
+        current.values[(size_t) i] = raw[(size_t) i]->load();
+}
+
+const SnapshotBank::Snapshot* SnapshotBank::beginBlock (int numSamples) noexcept
+{
+    if (auto* next = pending.load())
+    {
+        // Réserver la cible avant de vider 'pending'; si un rappel plus récent
+        // l'a remplacée entre-temps, il sera pris au bloc suivant.
+        audioTarget.store (next);
+
+        Snapshot* expected = next;
+        if (pending.compare_exchange_strong (expected, nullptr))
+        {
+            // Départ du morphing: valeurs effectivement utilisées au bloc précédent
+            start  = current;
+            target = next;
+            morphPos = 0;
+            morphLength = (int) std::round (getMorphTime() * sr);
+        }
+        else
+        {
+            audioTarget.store (target);
+        }
+    }
+
+    if (target == nullptr)
+    {
+        // Hors morphing: mémoriser les valeurs hôte de ce bloc comme point de départ
+        for (int i = 0; i < numParams; ++i)
+            current.values[(size_t) i] = raw[(size_t) i]->load (std::memory_order_relaxed);
+
+        return nullptr;
+    }
+
+    morphPos = juce::jmin (morphPos + numSamples, morphLength);
+    const float t = morphLength > 0 ? (float) morphPos / (float) morphLength : 1.0f;
+
+    for (int i = 0; i < numParams; ++i)
+    {
+        const float a = start.values[(size_t) i];
+        current.values[(size_t) i] = a + t * (target->values[(size_t) i] - a);
+    }
+
+    // Morphing terminé et paramètres hôte à jour: la cible n'est plus imposée
+    if (morphPos >= morphLength && hostApplied.load() == target)
+    {
+        target = nullptr;
+        audioTarget.store (nullptr);
+    }
+
+    return &current;
+}
@@ -0,0 +1,93 @@
+//============================== ParameterSnapshots.h ===============================
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ * Banque de snapshots de paramètres pour rappel instantané.
+ *
+ * Les snapshots sont compilés sur le thread message en structures POD plates
+ * (valeurs réelles, dans l'ordre des paramètres du processeur). Le thread audio
+ * les récupère par échange atomique de pointeur et calcule, par bloc, un
+ * morphing linéaire depuis les valeurs courantes. Aucun accès ValueTree/XML,
+ * verrou ou allocation côté audio. La cible reste imposée après le morphing
+ * tant que recall() n'a pas fini de mettre à jour les paramètres hôte.
+ */
+class SnapshotBank
+{
+public:
+    static constexpr int kNumSlots  = 8;
+    static constexpr int kMaxParams = 32;
+
+    // Valeurs réelles, indexées comme les paramètres du processeur
+    struct Snapshot
+    {
+        int numParams = 0;
+        std::array<float, kMaxParams> values {};
+    };
+
+    explicit SnapshotBank (juce::AudioProcessorValueTreeState&);
+
+    // Index d'un paramètre dans Snapshot::values (-1 si inconnu)
+    int indexOf (const juce::String& parameterID) const noexcept;
+
+    //==============================================================================
+    // Thread message
+    void capture (int slot);
+    bool recall (int slot);
+
+    // Durée de morphing appliquée aux rappels suivants (0 = instantané)
+    void   setMorphTime (double seconds) noexcept   { morphTime.store (juce::jmax (0.0, seconds)); }
+    double getMorphTime() const noexcept            { return morphTime.load(); }
+
+    bool hasSnapshot (int slot) const noexcept;
+    int  getCurrentSlot() const noexcept                { return currentSlot.load(); }
+    juce::String getSlotName (int slot) const;
+    void setSlotName (int slot, const juce::String& name);
+
+    // Persistance (enfant "SNAPSHOTS" de l'état)
+    juce::ValueTree toValueTree() const;
+    void fromValueTree (const juce::ValueTree&);
+
+    static const juce::Identifier stateType;
+
+    //==============================================================================
+    // Thread audio
+    void prepare (double sampleRate) noexcept;
+
+    // Renvoie les valeurs à utiliser pendant un morphing, nullptr sinon
+    const Snapshot* beginBlock (int numSamples) noexcept;
+
+private:
+    Snapshot* acquireFreeEntry() noexcept;
+    void      captureInto (Snapshot&) const;
+
+    juce::AudioProcessorValueTreeState& state;
+
+    // Table des paramètres (fixée à la construction)
+    int numParams = 0;
+    std::array<juce::RangedAudioParameter*, kMaxParams> params {};
+    std::array<std::atomic<float>*, kMaxParams>         raw {};
+
+    // Réserve d'entrées immuables une fois publiées (slots + cible en attente + cible audio)
+    static constexpr int kPoolSize = kNumSlots + 3;
+    std::array<Snapshot, kPoolSize>          pool {};
+    std::array<Snapshot*, kNumSlots>         slots {};
+    std::array<juce::String, kNumSlots>      names;
+    std::atomic<int> currentSlot { 0 };
+
+    // Échange sans attente message -> audio
+    std::atomic<Snapshot*>       pending     { nullptr };
+    std::atomic<const Snapshot*> audioTarget { nullptr };
+    std::atomic<const Snapshot*> hostApplied { nullptr };  // paramètres hôte à jour pour ce snapshot
+    std::atomic<double>          morphTime   { 0.0 };
+
+    // État propre au thread audio
+    double   sr = 48000.0;
+    Snapshot start, current;
+    const Snapshot* target = nullptr;
+    int      morphPos = 0, morphLength = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SnapshotBank)
+};
@@ -0,0 +1,891 @@
+//============================== PartitionedConvolver.cpp ===============================
+#include "PartitionedConvolver.h"
+#include <cmath>
+#include <cstring>
+
+//==============================================================================
+namespace
+{
+    int partitionsFor (int irLength, int offset, int end, int blockSize)
+    {
+        const int last = end > 0 ? juce::jmin (irLength, end) : irLength;
+        return last > offset ? (last - offset + blockSize - 1) / blockSize : 0;
+    }
+
+    // Décalage de grille des instances successives (suite de Fibonacci multiplicative)
+    std::atomic<juce::uint32> numInstances { 0 };
+
+    int fftOrder (int fftSize)
+    {
+        return juce::roundToInt (std::log2 ((double) fftSize));
+    }
+
+    // Sortie FFT réelle JUCE (complexes entrelacés) → parties séparées
+    void deinterleave (const float* src, float* re, float* im, int numBins) noexcept
+    {
+        for (int k = 0; k < numBins; ++k)
+        {
+            re[k] = src[2 * k];
+            im[k] = src[2 * k + 1];
+        }
+    }
+}
+
+//==============================================================================
+PartitionedConvolver::PartitionedConvolver()
+    : gridPhase (numInstances.fetch_add (1, std::memory_order_relaxed) * 0x9E3779B9u)
+{
+}
+
+PartitionedConvolver::~PartitionedConvolver()
+{
+    if (registered)
+        thread->removeTimeSliceClient (this);
+}
+
+//==============================================================================
+void PartitionedConvolver::prepare (double sampleRate, int samplesPerBlock)
+{
+    // Le thread de fond ne touche plus aux moteurs pendant la réallocation
+    if (registered)
+    {
+        thread->removeTimeSliceClient (this);
+        registered = false;
+    }
+
+    sr = sampleRate > 0.0 ? sampleRate : 48000.0;
+    maxIrLength = (int) std::ceil (kMaxSeconds * sr);
+
+    // Blocs de fond d'au moins un bloc hôte: l'échéance tombe dans un callback ultérieur
+    const int bg = juce::jmax (512, juce::nextPowerOfTwo (juce::jmax (1, samplesPerBlock)));
+
+    layout[0] = {   64,       64,     1024, 0, false };
+    layout[1] = {  512,     1024,   2 * bg, 0, false };
+    layout[2] = {   bg,   2 * bg,  16 * bg, 0, true  };
+    layout[3] = { 8 * bg, 16 * bg,       0, 0, true  };
+
+    int largest = kHeadSize;
+    for (auto& l : layout)
+    {
+        l.lead = l.offset - (l.background ? 2 : 1) * l.blockSize;
+        largest = juce::jmax (largest, l.lead + l.blockSize);
+    }
+
+    ringSize = juce::nextPowerOfTwo (largest + kHeadSize);
+
+    for (auto& e : engines)
+    {
+        allocateEngine (e);
+        resetEngine (e, nullptr);
+        e.running = false;
+        e.owner.store (engineFree, std::memory_order_relaxed);
+    }
+
+    // FFT du chargeur pour les seuls étages qu'une RI de kMaxSeconds peut atteindre
+    int loaderBlock = 0;
+    for (int s = 0; s < kNumStages; ++s)
+    {
+        const auto& l = layout[(size_t) s];
+        const bool used = partitionsFor (maxIrLength, l.offset, l.end, l.blockSize) > 0;
+
+        loader.ffts[(size_t) s] = used ? std::make_unique<juce::dsp::FFT> (fftOrder (2 * l.blockSize)) : nullptr;
+        loaderBlock = used ? juce::jmax (loaderBlock, l.blockSize) : loaderBlock;
+    }
+
+    loader.work.assign ((size_t) (4 * loaderBlock), 0.0f);
+    loader.kernel.reset();
+    loader.ir.setSize (0, 0);
+
+    active        = 0;
+    fadeRemaining = 0;
+    fadeLength    = juce::jmax (1, (int) std::round (kCrossfadeSeconds * sr));
+    position      = ((juce::uint64) gridPhase * (juce::uint64) layout[kNumStages - 1].blockSize) >> 32;
+
+    // RI déjà chargée: reconstruite à la nouvelle fréquence, active sans fondu
+    juce::AudioBuffer<float> ir;
+    double irSampleRate = 0.0;
+    {
+        const juce::ScopedLock sl (sourceLock);
+        ir = sourceIr;
+        irSampleRate = sourceIrRate;
+        loader.serial = sourceSerial.load (std::memory_order_relaxed);
+    }
+
+    tailSeconds.store (0.0, std::memory_order_relaxed);
+
+    if (ir.getNumSamples() > 0)
+    {
+        auto k = buildKernel (conformIr (ir, irSampleRate));
+        tailSeconds.store ((double) k->length / sr, std::memory_order_relaxed);
+
+        resetEngine (engines[0], std::move (k));
+        engines[0].running = true;
+        engines[0].owner.store (engineAudio, std::memory_order_relaxed);
+    }
+
+    thread->addTimeSliceClient (this);
+    registered = true;
+}
+
+void PartitionedConvolver::allocateEngine (Engine& e)
+{
+    auto allocateScratch = [] (Scratch& sc, int fftSize)
+    {
+        const auto nb = (size_t) (fftSize / 2 + 1);
+        sc.fft = std::make_unique<juce::dsp::FFT> (fftOrder (fftSize));
+
+        for (int ch = 0; ch < kMaxChannels; ++ch)
+        {
+            sc.re    [(size_t) ch].assign (nb, 0.0f);
+            sc.im    [(size_t) ch].assign (nb, 0.0f);
+            sc.result[(size_t) ch].assign ((size_t) (fftSize / 2), 0.0f);
+        }
+
+        sc.work .assign ((size_t) (2 * fftSize), 0.0f);
+        sc.accRe.assign (nb, 0.0f);
+        sc.accIm.assign (nb, 0.0f);
+    };
+
+    auto release = [] (auto& v) { v.clear(); v.shrink_to_fit(); };
+
+    auto releaseScratch = [&release] (Scratch& sc)
+    {
+        sc.fft.reset();
+        for (int ch = 0; ch < kMaxChannels; ++ch)
+        {
+            release (sc.re[(size_t) ch]);
+            release (sc.im[(size_t) ch]);
+            release (sc.result[(size_t) ch]);
+        }
+
+        release (sc.work);
+        release (sc.accRe);
+        release (sc.accIm);
+    };
+
+    for (int s = 0; s < kNumStages; ++s)
+    {
+        auto& st = e.stages[(size_t) s];
+        st.layout   = layout[(size_t) s];
+        st.index    = s;
+        st.fftSize  = 2 * st.layout.blockSize;
+        st.numBins  = st.layout.blockSize + 1;
+        st.capacity = partitionsFor (maxIrLength, st.layout.offset, st.layout.end, st.layout.blockSize);
+
+        // Étage hors de portée d'une RI de kMaxSeconds (grands blocs hôte): jamais utilisé
+        if (st.capacity == 0)
+        {
+            for (int ch = 0; ch < kMaxChannels; ++ch)
+            {
+                release (st.accum[(size_t) ch]);
+                release (st.previous[(size_t) ch]);
+                release (st.fdlRe[(size_t) ch]);
+                release (st.fdlIm[(size_t) ch]);
+            }
+
+            release (st.window);
+            releaseScratch (st.local);
+
+            for (auto& job : st.jobs)
+            {
+                for (auto& in : job.input)
+                    release (in);
+
+                release (job.slots);
+                releaseScratch (job.scratch);
+            }
+
+            continue;
+        }
+
+        const auto B = (size_t) st.layout.blockSize;
+        const auto fdlSize = (size_t) ((st.capacity + 1) * st.numBins);
+
+        for (int ch = 0; ch < kMaxChannels; ++ch)
+        {
+            st.accum   [(size_t) ch].assign (B, 0.0f);
+            st.previous[(size_t) ch].assign (B, 0.0f);
+            st.fdlRe   [(size_t) ch].assign (fdlSize, 0.0f);
+            st.fdlIm   [(size_t) ch].assign (fdlSize, 0.0f);
+        }
+
+        st.window.assign ((size_t) juce::jmax (1, st.capacity), 0);
+        allocateScratch (st.local, st.fftSize);
+
+        for (auto& job : st.jobs)
+        {
+            for (auto& in : job.input)
+                in.assign (2 * B, 0.0f);
+
+            job.slots.assign ((size_t) juce::jmax (1, st.capacity), 0);
+            allocateScratch (job.scratch, st.fftSize);
+        }
+    }
+
+    for (int ch = 0; ch < kMaxChannels; ++ch)
+    {
+        e.history[(size_t) ch].assign ((size_t) (2 * kHeadSize - 1), 0.0f);
+        e.ring   [(size_t) ch].assign ((size_t) ringSize, 0.0f);
+    }
+}
+
+void PartitionedConvolver::resetEngine (Engine& e, std::unique_ptr<const Kernel> k) noexcept
+{
+    auto zero = [] (std::vector<float>& v, size_t n) { std::fill (v.begin(), v.begin() + (std::ptrdiff_t) n, 0.0f); };
+
+    // Ancien noyau libéré ici: thread de fond (moteur libre) ou thread message
+    e.kernel = std::move (k);
+
+    for (auto& st : e.stages)
+    {
+        st.partitions = e.kernel != nullptr ? juce::jmin (e.kernel->stages[(size_t) st.index][0].numPartitions, st.capacity) : 0;
+        st.inFlight   = -1;
+
+        if (st.capacity == 0)
+            continue;
+
+        // Seules les cases utilisées par ce noyau (et la réserve) sont remises à zéro
+        const auto used = (size_t) ((st.partitions + 1) * st.numBins);
+
+        for (int ch = 0; ch < kMaxChannels; ++ch)
+        {
+            zero (st.accum[(size_t) ch], st.accum[(size_t) ch].size());
+            zero (st.previous[(size_t) ch], st.previous[(size_t) ch].size());
+            zero (st.fdlRe[(size_t) ch], used);
+            zero (st.fdlIm[(size_t) ch], used);
+        }
+
+        for (int p = 0; p < st.partitions; ++p)
+            st.window[(size_t) p] = p;
+
+        st.newest = 0;
+        st.spare  = st.partitions;
+
+        for (auto& job : st.jobs)
+        {
+            job.numChannels = 0;
+            job.kernel = nullptr;
+            job.busySlot.store (-1, std::memory_order_relaxed);
+            job.state.store (jobIdle, std::memory_order_relaxed);
+        }
+    }
+
+    for (int ch = 0; ch < kMaxChannels; ++ch)
+    {
+        zero (e.history[(size_t) ch], e.history[(size_t) ch].size());
+        zero (e.ring   [(size_t) ch], e.ring   [(size_t) ch].size());
+    }
+}
+
+//==============================================================================
+void PartitionedConvolver::setImpulseResponse (const juce::AudioBuffer<float>& ir, double irSampleRate)
+{
+    const int numChannels = juce::jmin (ir.getNumChannels(), kMaxChannels);
+    if (numChannels == 0 || ir.getNumSamples() == 0 || irSampleRate <= 0.0)
+    {
+        clearImpulseResponse();
+        return;
+    }
+
+    // Copie tronquée à kMaxSeconds (à sa propre fréquence); noyau construit par le thread de fond
+    const int length = juce::jmin (ir.getNumSamples(), (int) std::ceil (kMaxSeconds * irSampleRate));
+
+    const juce::ScopedLock sl (sourceLock);
+    sourceIr.setSize (numChannels, length);
+    for (int ch = 0; ch < numChannels; ++ch)
+        sourceIr.copyFrom (ch, 0, ir, ch, 0, length);
+
+    sourceIrRate = irSampleRate;
+    sourceSerial.fetch_add (1, std::memory_order_release);
+}
+
+void PartitionedConvolver::clearImpulseResponse()
+{
+    // Noyau vide: fondu vers le signal sec
+    const juce::ScopedLock sl (sourceLock);
+    sourceIr.setSize (0, 0);
+    sourceSerial.fetch_add (1, std::memory_order_release);
+}
+
+juce::AudioBuffer<float> PartitionedConvolver::conformIr (const juce::AudioBuffer<float>& ir, double irSampleRate) const
+{
+    // Rééchantillonnage à la fréquence de travail
+    const double ratio = irSampleRate / sr;
+    if (std::abs (ratio - 1.0) < 1.0e-9)
+        return ir;
+
+    const int numIn  = ir.getNumSamples();
+    const int length = juce::jmin (maxIrLength, (int) std::ceil (numIn / ratio));
+    juce::AudioBuffer<float> out (ir.getNumChannels(), length);
+
+    // Décimation: sinc fenêtré (Blackman) coupant sous la nouvelle fréquence de
+    // Nyquist. L'interpolation seule replierait le haut du spectre de la RI.
+    if (ratio > 1.0)
+    {
+        constexpr int    kZeroCrossings = 16;
+        constexpr int    kPhases        = 256;                         // pas de la table: 1/256 d'échantillon
+        constexpr double kCutoff        = 0.45;                        // en fraction de la fréquence de travail
+        const double fc   = kCutoff / ratio;                           // en cycles par échantillon de la RI
+        const int    half = (int) std::ceil (kZeroCrossings / (2.0 * fc));
+
+        // Noyau tabulé sur [-half, half], interpolé linéairement entre deux phases
+        std::vector<float> kernel ((size_t) (2 * half * kPhases + 2), 0.0f);
+        for (size_t j = 0; j < kernel.size() - 1; ++j)
+        {
+            const double d = (double) j / kPhases - half;
+            const double a = juce::MathConstants<double>::twoPi * fc * d;
+            const double w = juce::MathConstants<double>::pi * d / half;
+            const double sinc = a != 0.0 ? std::sin (a) / a : 1.0;
+
+            kernel[j] = (float) (2.0 * fc * sinc * (0.42 + 0.5 * std::cos (w) + 0.08 * std::cos (2.0 * w)));
+        }
+
+        for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+        {
+            const float* x = ir.getReadPointer (ch);
+            float* y = out.getWritePointer (ch);
+
+            for (int n = 0; n < length; ++n)
+            {
+                const double t     = n * ratio;
+                const int    whole = (int) t;
+                const double phase = (t - whole) * kPhases;
+                const int    p     = (int) phase;
+                const float  f     = (float) (phase - p);
+
+                // Échantillon i: d = t - i, entrée de table (whole - i + half) * kPhases + p
+                const int first = juce::jmax (0, whole - half + 1);
+                const int last  = juce::jmin (numIn - 1, whole + half);
+                float acc = 0.0f;
+
+                for (int i = first; i <= last; ++i)
+                {
+                    const float* k = kernel.data() + (whole - i + half) * kPhases + p;
+                    acc += x[i] * (k[0] + f * (k[1] - k[0]));
+                }
+
+                y[n] = acc;
+            }
+        }
+
+        return out;
+    }
+
+    // Suréchantillonnage: pas de repliement, interpolation directe.
+    // Entrée complétée par des zéros: l'interpolateur lit un peu au-delà de la fin
+    juce::AudioBuffer<float> padded (1, numIn + 8 + 2 * (int) std::ceil (ratio));
+
+    for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+    {
+        padded.clear();
+        padded.copyFrom (0, 0, ir, ch, 0, numIn);
+
+        juce::LagrangeInterpolator interpolator;
+        interpolator.process (ratio, padded.getReadPointer (0), out.getWritePointer (ch), length);
+    }
+
+    return out;
+}
+
+std::unique_ptr<PartitionedConvolver::Kernel> PartitionedConvolver::createKernel (const juce::AudioBuffer<float>& ir) const
+{
+    // Tête directe et spectres alloués; partitions calculées par buildPartition()
+    auto k = std::make_unique<Kernel>();
+    k->numChannels = juce::jmin (ir.getNumChannels(), kMaxChannels);
+    k->length = k->numChannels > 0 ? juce::jmin (ir.getNumSamples(), maxIrLength) : 0;
+
+    for (int ch = 0; ch < k->numChannels; ++ch)
+    {
+        const float* h = ir.getReadPointer (ch);
+        for (int i = 0; i < juce::jmin (k->length, kHeadSize); ++i)
+            k->head[(size_t) ch][(size_t) i] = h[i];
+    }
+
+    for (int s = 0; s < kNumStages; ++s)
+    {
+        const auto& l = layout[(size_t) s];
+        const int P = partitionsFor (k->length, l.offset, l.end, l.blockSize);
+        const auto size = (size_t) (P * (l.blockSize + 1));
+
+        for (int ch = 0; ch < k->numChannels; ++ch)
+        {
+            auto& spectra = k->stages[(size_t) s][(size_t) ch];
+            spectra.numPartitions = P;
+            spectra.re.assign (size, 0.0f);
+            spectra.im.assign (size, 0.0f);
+        }
+    }
+
+    return k;
+}
+
+void PartitionedConvolver::buildPartition (Kernel& k, const juce::AudioBuffer<float>& ir, int stage, int partition) noexcept
+{
+    const auto& l = layout[(size_t) stage];
+    const int B  = l.blockSize;
+    const int nb = B + 1;
+    float* work  = loader.work.data();
+
+    // Partition p: B échantillons de RI, complétés par B zéros
+    const int first = l.offset + partition * B;
+    const int count = juce::jmin (B, k.length - first);
+
+    for (int ch = 0; ch < k.numChannels; ++ch)
+    {
+        auto& spectra = k.stages[(size_t) stage][(size_t) ch];
+
+        juce::FloatVectorOperations::clear (work, 4 * B);
+        std::memcpy (work, ir.getReadPointer (ch) + first, sizeof (float) * (size_t) count);
+
+        loader.ffts[(size_t) stage]->performRealOnlyForwardTransform (work, true);
+        deinterleave (work, spectra.re.data() + partition * nb, spectra.im.data() + partition * nb, nb);
+    }
+}
+
+std::unique_ptr<PartitionedConvolver::Kernel> PartitionedConvolver::buildKernel (const juce::AudioBuffer<float>& ir)
+{
+    auto k = createKernel (ir);
+
+    for (int s = 0; s < kNumStages; ++s)
+        for (int p = 0; p < k->stages[(size_t) s][0].numPartitions; ++p)
+            buildPartition (*k, ir, s, p);
+
+    return k;
+}
+
+bool PartitionedConvolver::loadStep()
+{
+    // Nouvelle demande: copie, rééchantillonnage et tête directe (un noyau en cours est abandonné)
+    if (sourceSerial.load (std::memory_order_acquire) != loader.serial)
+    {
+        juce::AudioBuffer<float> ir;
+        double irSampleRate = 0.0;
+        {
+            const juce::ScopedLock sl (sourceLock);
+            ir = sourceIr;
+            irSampleRate = sourceIrRate;
+            loader.serial = sourceSerial.load (std::memory_order_relaxed);
+        }
+
+        loader.ir = ir.getNumSamples() > 0 ? conformIr (ir, irSampleRate) : juce::AudioBuffer<float>();
+        loader.kernel = createKernel (loader.ir);
+        loader.stage = loader.partition = 0;
+        return true;
+    }
+
+    if (loader.kernel == nullptr)
+        return false;
+
+    // Une partition (tous canaux) par tranche: les tâches des étages passent entre deux
+    auto& k = *loader.kernel;
+    while (loader.stage < kNumStages && loader.partition >= k.stages[(size_t) loader.stage][0].numPartitions)
+    {
+        ++loader.stage;
+        loader.partition = 0;
+    }
+
+    if (loader.stage < kNumStages)
+    {
+        buildPartition (k, loader.ir, loader.stage, loader.partition++);
+        return true;
+    }
+
+    // Noyau complet: remplace un moteur prêt mais pas encore adopté
+    for (auto& e : engines)
+    {
+        int expected = engineReady;
+        e.owner.compare_exchange_strong (expected, engineFree, std::memory_order_acquire);
+    }
+
+    for (auto& e : engines)
+    {
+        if (e.owner.load (std::memory_order_acquire) != engineFree)
+            continue;
+
+        tailSeconds.store ((double) k.length / sr, std::memory_order_relaxed);
+
+        resetEngine (e, std::move (loader.kernel));
+        loader.ir.setSize (0, 0);
+
+        e.owner.store (engineReady, std::memory_order_release);
+        return true;
+    }
+
+    // Les deux moteurs sont au thread audio (fondu en cours): nouvel essai à la tranche suivante
+    return false;
+}
+
+//==============================================================================
+void PartitionedConvolver::beginBlock() noexcept
+{
+    // Moteur arrêté: rendu au thread de fond dès qu'aucune tâche ne l'utilise
+    for (auto& e : engines)
+        if (! e.running && e.owner.load (std::memory_order_relaxed) == engineAudio && cancelJobs (e))
+            e.owner.store (engineFree, std::memory_order_release);
+
+    if (fadeRemaining > 0)
+        return;
+
+    // Moteur préparé par le thread de fond
+    for (int i = 0; i < (int) engines.size(); ++i)
+    {
+        auto& e = engines[(size_t) i];
+
+        int expected = engineReady;
+        if (! e.owner.compare_exchange_strong (expected, engineAudio, std::memory_order_acquire))
+            continue;
+
+        // Seul le moteur actif peut tourner hors fondu
+        const bool wasRunning = i != active && engines[(size_t) active].running;
+        e.running = e.kernel->numChannels > 0;
+
+        // Fondu de l'ancien moteur (ou du signal sec) vers le nouveau (ou le signal sec)
+        if (e.running || wasRunning)
+        {
+            active = i;
+            fadeRemaining = fadeLength;
+        }
+
+        return;
+    }
+}
+
+void PartitionedConvolver::processChunk (int numChannels, int numSamples) noexcept
+{
+    auto render = [this, numChannels, numSamples] (Engine& e, ChunkBuffers& out)
+    {
+        if (e.running)
+            processEngine (e, numChannels, numSamples, out);
+        else
+            for (int ch = 0; ch < numChannels; ++ch)
+                std::memcpy (out[(size_t) ch].data(), dry[(size_t) ch].data(), sizeof (float) * (size_t) numSamples);
+    };
+
+    render (engines[(size_t) active], wet);
+
+    if (fadeRemaining > 0)
+    {
+        render (engines[(size_t) (1 - active)], scratch);
+
+        const float step  = 1.0f / (float) fadeLength;
+        const float start = (float) (fadeLength - fadeRemaining) * step;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto& w = wet[(size_t) ch];
+            const auto& o = scratch[(size_t) ch];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float t = juce::jmin (1.0f, start + (float) (i + 1) * step);
+                w[(size_t) i] = o[(size_t) i] + t * (w[(size_t) i] - o[(size_t) i]);
+            }
+        }
+
+        fadeRemaining -= numSamples;
+        if (fadeRemaining <= 0)
+        {
+            fadeRemaining = 0;
+            engines[(size_t) (1 - active)].running = false;
+        }
+    }
+
+    position += (juce::uint64) numSamples;
+}
+
+void PartitionedConvolver::processEngine (Engine& e, int numChannels, int numSamples, ChunkBuffers& out) noexcept
+{
+    const Kernel& k = *e.kernel;
+    const auto ringStart = (size_t) (position & (juce::uint64) (ringSize - 1));
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const int kc = juce::jmin (ch, k.numChannels - 1);
+        float* o = out[(size_t) ch].data();
+
+        // Tête directe: x0[-t] = entrée t échantillons plus tôt
+        auto& hist = e.history[(size_t) ch];
+        float* x0 = hist.data() + kHeadSize - 1;
+        std::memcpy (x0, dry[(size_t) ch].data(), sizeof (float) * (size_t) numSamples);
+
+        juce::FloatVectorOperations::clear (o, numSamples);
+        for (int t = 0; t < kHeadSize; ++t)
+            if (const float h = k.head[(size_t) kc][(size_t) t]; h != 0.0f)
+                juce::FloatVectorOperations::addWithMultiply (o, x0 - t, h, numSamples);
+
+        std::memmove (hist.data(), hist.data() + numSamples, sizeof (float) * (size_t) (kHeadSize - 1));
+
+        // Résultats des étages arrivés à échéance
+        float* r = e.ring[(size_t) ch].data() + ringStart;
+        juce::FloatVectorOperations::add (o, r, numSamples);
+        juce::FloatVectorOperations::clear (r, numSamples);
+
+        // Entrée des étages
+        for (auto& st : e.stages)
+        {
+            if (st.partitions == 0)
+                continue;
+
+            const auto offset = (size_t) (position % (juce::uint64) st.layout.blockSize);
+            std::memcpy (st.accum[(size_t) ch].data() + offset, dry[(size_t) ch].data(), sizeof (float) * (size_t) numSamples);
+        }
+    }
+
+    const auto boundary = position + (juce::uint64) numSamples;
+
+    for (auto& st : e.stages)
+        if (st.partitions > 0 && boundary % (juce::uint64) st.layout.blockSize == 0)
+            stageBoundary (e, st, numChannels, boundary);
+}
+
+void PartitionedConvolver::stageBoundary (Engine& e, Stage& st, int numChannels, juce::uint64 boundary) noexcept
+{
+    const int B = st.layout.blockSize;
+
+    // Bloc calculé: spectre dans la ligne à retard, sortie dans l'anneau à partir
+    // de la frontière (avancée pour un étage direct qui ne commence pas à son bloc)
+    auto deliver = [&] (const Scratch& out, int channels)
+    {
+        commit (st, out, channels);
+
+        const auto start = (int) ((boundary + (juce::uint64) st.layout.lead) & (juce::uint64) (ringSize - 1));
+        const int  first = juce::jmin (B, ringSize - start);
+
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            auto* ring = e.ring[(size_t) ch].data();
+            const auto* res = out.result[(size_t) ch].data();
+            juce::FloatVectorOperations::add (ring + start, res, first);
+            if (first < B)
+                juce::FloatVectorOperations::add (ring, res + first, B - first);
+        }
+    };
+
+    // Échéance de la tâche lancée à la frontière précédente
+    if (st.inFlight >= 0)
+    {
+        auto& job = st.jobs[(size_t) st.inFlight];
+        st.inFlight = -1;
+
+        int expected = jobPending;
+        if (job.state.compare_exchange_strong (expected, jobIdle, std::memory_order_acquire))
+        {
+            // Pas démarrée: calculée ici
+            computeJob (st, job, st.local, false);
+            deliver (st.local, job.numChannels);
+        }
+        else if (expected == jobRunning && job.state.compare_exchange_strong (expected, jobAbandoned))
+        {
+            // En cours: abandonnée et recalculée ici, entrées partagées en lecture seule
+            computeJob (st, job, st.local, false);
+            deliver (st.local, job.numChannels);
+        }
+        else
+        {
+            jassert (expected == jobDone);
+            deliver (job.scratch, job.numChannels);
+            job.state.store (jobIdle, std::memory_order_relaxed);
+        }
+    }
+
+    Job* job = nullptr;
+    for (auto& j : st.jobs)
+    {
+        if (j.state.load (std::memory_order_acquire) == jobIdle)
+        {
+            job = &j;
+            break;
+        }
+    }
+
+    jassert (job != nullptr);
+    if (job == nullptr)
+        return;
+
+    // Bloc complet: [précédent | courant] devient l'entrée de la tâche
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto& in = job->input[(size_t) ch];
+        std::memcpy (in.data(),     st.previous[(size_t) ch].data(), sizeof (float) * (size_t) B);
+        std::memcpy (in.data() + B, st.accum   [(size_t) ch].data(), sizeof (float) * (size_t) B);
+        std::swap (st.previous[(size_t) ch], st.accum[(size_t) ch]);
+    }
+
+    // Cases des blocs précédents, figées pour la durée de la tâche
+    const int P = st.partitions;
+    for (int p = 1; p < P; ++p)
+        job->slots[(size_t) (p - 1)] = st.window[(size_t) ((st.newest - (p - 1) + P) % P)];
+
+    job->numChannels = numChannels;
+    job->kernel      = e.kernel.get();
+
+    if (st.layout.background)
+    {
+        st.inFlight = (int) (job - st.jobs.data());
+        job->state.store (jobPending, std::memory_order_release);
+    }
+    else
+    {
+        computeJob (st, *job, st.local, false);
+        deliver (st.local, numChannels);
+    }
+}
+
+bool PartitionedConvolver::computeJob (const Stage& st, Job& job, Scratch& out, bool background) noexcept
+{
+    const Kernel& k = *job.kernel;
+    const int B  = st.layout.blockSize;
+    const int N  = st.fftSize;
+    const int nb = st.numBins;
+    const int P  = st.partitions;
+
+    float* w   = out.work.data();
+    float* are = out.accRe.data();
+    float* aim = out.accIm.data();
+
+    for (int ch = 0; ch < job.numChannels; ++ch)
+    {
+        const auto& spectra = k.stages[(size_t) st.index][(size_t) juce::jmin (ch, k.numChannels - 1)];
+        float* xr = out.re[(size_t) ch].data();
+        float* xi = out.im[(size_t) ch].data();
+
+        // Spectre du bloc courant
+        std::memcpy (w, job.input[(size_t) ch].data(), sizeof (float) * (size_t) N);
+        juce::FloatVectorOperations::clear (w + N, N);
+        out.fft->performRealOnlyForwardTransform (w, true);
+        deinterleave (w, xr, xi, nb);
+
+        // Y = Σ X[k - p] · H[p], parties séparées (SIMD)
+        auto multiplyAdd = [&] (const float* yr, const float* yi, int p)
+        {
+            const float* hr = spectra.re.data() + p * nb;
+            const float* hi = spectra.im.data() + p * nb;
+
+            juce::FloatVectorOperations::addWithMultiply      (are, yr, hr, nb);
+            juce::FloatVectorOperations::subtractWithMultiply (are, yi, hi, nb);
+            juce::FloatVectorOperations::addWithMultiply      (aim, yr, hi, nb);
+            juce::FloatVectorOperations::addWithMultiply      (aim, yi, hr, nb);
+        };
+
+        juce::FloatVectorOperations::clear (are, nb);
+        juce::FloatVectorOperations::clear (aim, nb);
+        multiplyAdd (xr, xi, 0);
+
+        for (int p = 1; p < P; ++p)
+        {
+            const int slot = job.slots[(size_t) (p - 1)];
+
+            // Thread de fond: case annoncée avant lecture, puis abandon vérifié (seq_cst des deux côtés)
+            if (background)
+            {
+                job.busySlot.store (slot);
+                if (job.state.load() == jobAbandoned)
+                    return false;
+            }
+
+            multiplyAdd (st.fdlRe[(size_t) ch].data() + slot * nb, st.fdlIm[(size_t) ch].data() + slot * nb, p);
+        }
+
+        // Spectre complet (symétrie hermitienne) puis retour temporel; seconde moitié valide
+        for (int i = 0; i < nb; ++i)
+        {
+            w[2 * i]     = are[i];
+            w[2 * i + 1] = aim[i];
+        }
+        for (int i = nb; i < N; ++i)
+        {
+            w[2 * i]     =  are[N - i];
+            w[2 * i + 1] = -aim[N - i];
+        }
+
+        out.fft->performRealOnlyInverseTransform (w);
+        std::memcpy (out.result[(size_t) ch].data(), w + B, sizeof (float) * (size_t) B);
+    }
+
+    return true;
+}
+
+void PartitionedConvolver::commit (Stage& st, const Scratch& out, int numChannels) noexcept
+{
+    // X[k] remplace X[k - P], la case la plus ancienne
+    st.newest = (st.newest + 1) % st.partitions;
+    auto& slot = st.window[(size_t) st.newest];
+
+    // Case encore lue par une tâche abandonnée (au plus une): échangée avec la réserve
+    for (auto& job : st.jobs)
+        if (job.busySlot.load() == slot)
+            std::swap (slot, st.spare);
+
+    const auto offset = (size_t) (slot * st.numBins);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        std::memcpy (st.fdlRe[(size_t) ch].data() + offset, out.re[(size_t) ch].data(), sizeof (float) * (size_t) st.numBins);
+        std::memcpy (st.fdlIm[(size_t) ch].data() + offset, out.im[(size_t) ch].data(), sizeof (float) * (size_t) st.numBins);
+    }
+}
+
+bool PartitionedConvolver::cancelJobs (Engine& e) noexcept
+{
+    bool allIdle = true;
+
+    for (auto& st : e.stages)
+    {
+        st.inFlight = -1;
+
+        for (auto& job : st.jobs)
+        {
+            int s = job.state.load (std::memory_order_acquire);
+
+            // En attente ou terminée: libérée; en cours: abandonnée, arrêt à la partition suivante
+            if ((s == jobPending || s == jobDone) && job.state.compare_exchange_strong (s, jobIdle, std::memory_order_acquire))
+                continue;
+
+            if (s == jobRunning)
+                job.state.compare_exchange_strong (s, jobAbandoned);
+
+            if (s != jobIdle)
+                allIdle = false;
+        }
+    }
+
+    return allIdle;
+}
+
+//==============================================================================
+int PartitionedConvolver::useTimeSlice()
+{
+    bool worked = false;
+
+    for (auto& e : engines)
+    {
+        for (auto& st : e.stages)
+        {
+            if (! st.layout.background)
+                continue;
+
+            for (auto& job : st.jobs)
+            {
+                int expected = jobPending;
+                if (! job.state.compare_exchange_strong (expected, jobRunning, std::memory_order_acquire))
+                    continue;
+
+                computeJob (st, job, job.scratch, true);
+                job.busySlot.store (-1);
+
+                // Abandonnée entre-temps: le thread audio a calculé le bloc lui-même
+                expected = jobRunning;
+                if (! job.state.compare_exchange_strong (expected, jobDone, std::memory_order_acq_rel))
+                    job.state.store (jobIdle, std::memory_order_release);
+
+                worked = true;
+            }
+        }
+    }
+
+    // Changement de RI: une étape par tranche, après les tâches dues
+    if (loadStep())
+        worked = true;
+
+    return worked ? 0 : 1;
+}
@@ -0,0 +1,259 @@
+//============================== PartitionedConvolver.h ===============================
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * Convolution à partitions non uniformes, latence nulle.
+ *
+ * Découpage de la réponse impulsionnelle (RI), B = bloc hôte arrondi à la
+ * puissance de deux supérieure, au moins 512:
+ *   [0, 64)         tête directe (RIF), dans le callback;
+ *   [64, 1024)      blocs de 64, FFT 128, dans le callback;
+ *   [1024, 2B)      blocs de 512, FFT 1024, dans le callback (vide si B = 512);
+ *   [2B, 16B)       blocs de B, FFT 2B, thread de fond;
+ *   [16B, fin)      blocs de 8B, FFT 16B, thread de fond.
+ * Un étage de fond commence à deux fois sa taille de bloc: une tâche lancée à
+ * une frontière a jusqu'à la frontière suivante, au moins un bloc hôte plus
+ * tard, pour rendre son résultat. Avec des blocs de fond plus courts que le
+ * bloc hôte, l'échéance tomberait dans le même callback et le calcul se ferait
+ * toujours sur place. Chaque instance décale sa grille de blocs: les grandes
+ * frontières des instances ne coïncident pas sur le thread de fond partagé.
+ * Le thread audio n'attend jamais: à l'échéance, une tâche non
+ * démarrée est calculée sur place; une tâche en cours est abandonnée et
+ * recalculée sur place à partir des mêmes entrées (en lecture seule), le
+ * thread de fond s'arrêtant à la partition suivante. La sortie ne dépend pas
+ * de l'ordonnancement.
+ *
+ * Ligne à retard fréquentielle écrite par le thread audio seul, à travers une
+ * table de cases: la case qu'une tâche abandonnée lit encore n'est jamais
+ * réécrite (échangée avec une case de réserve).
+ *
+ * Spectres en parties réelle/imaginaire séparées: la multiplication-accumulation
+ * passe par FloatVectorOperations (SIMD). Changement de RI: le noyau est calculé
+ * par tranches sur le thread de fond, qui remet à zéro un moteur libre et le
+ * propose au thread audio; celui-ci l'adopte par fondu enchaîné. Mémoire allouée
+ * dans prepare() pour des RI jusqu'à kMaxSeconds: le coût par bloc ne dépend pas
+ * de la RI chargée.
+ */
+class PartitionedConvolver : private juce::TimeSliceClient
+{
+public:
+    static constexpr int    kMaxChannels = 2;
+    static constexpr double kMaxSeconds  = 2.0;
+    static constexpr int    kHeadSize    = 64;      // aussi le pas de traitement interne
+    static constexpr int    kNumStages   = 4;
+    static constexpr double kCrossfadeSeconds = 0.05;
+
+    PartitionedConvolver();
+    ~PartitionedConvolver() override;
+
+    // Thread message. Découpage fixé par le bloc hôte maximal; une RI déjà
+    // chargée est reconstruite ici, à la nouvelle fréquence.
+    void prepare (double sampleRate, int samplesPerBlock);
+
+    // Thread message: RI copiée et tronquée à kMaxSeconds; rééchantillonnée et
+    // appliquée par le thread de fond, puis par fondu enchaîné
+    void setImpulseResponse (const juce::AudioBuffer<float>& ir, double irSampleRate);
+    void clearImpulseResponse();
+
+    // Durée de la dernière RI préparée (0 sans RI)
+    double getTailSeconds() const noexcept      { return tailSeconds.load (std::memory_order_relaxed); }
+
+    // Thread audio: mix 0 = sec, 1 = convolué. Sans RI, le tampon est laissé intact.
+    template <typename Sample>
+    void process (juce::AudioBuffer<Sample>& buffer, float mix) noexcept;
+
+private:
+    //==============================================================================
+    struct StageLayout
+    {
+        int blockSize = 0;
+        int offset = 0;     // premier échantillon de RI couvert
+        int end = 0;        // fin de la plage couverte (exclue), 0 = fin de la RI
+        int lead = 0;       // avance de la sortie dans l'anneau (offset - bloc(s) de latence)
+        bool background = false;
+    };
+
+    // RI précalculée (thread de fond), immuable une fois proposée au thread audio
+    struct Kernel
+    {
+        int numChannels = 0, length = 0;
+        std::array<std::array<float, kHeadSize>, kMaxChannels> head {};
+
+        struct Spectra
+        {
+            int numPartitions = 0;
+            std::vector<float> re, im;          // partition p, case k: p * numBins + k
+        };
+
+        std::array<std::array<Spectra, kMaxChannels>, kNumStages> stages;
+    };
+
+    enum JobState { jobIdle = 0, jobPending, jobRunning, jobDone, jobAbandoned };
+
+    // Calcul d'un bloc: spectre X[k] du bloc, puis sortie temporelle
+    struct Scratch
+    {
+        std::unique_ptr<juce::dsp::FFT> fft;
+        std::array<std::vector<float>, kMaxChannels> re, im, result;
+        std::vector<float> work, accRe, accIm;
+    };
+
+    struct Job
+    {
+        // Écrit par le thread audio avant 'pending', lu seulement ensuite
+        std::array<std::vector<float>, kMaxChannels> input;     // [bloc précédent | bloc courant]
+        std::vector<int> slots;                                 // cases de X[k-1] .. X[k-P+1]
+        int numChannels = 0;
+        const Kernel* kernel = nullptr;
+
+        Scratch scratch;                                        // sortie du thread de fond
+        std::atomic<int> state { jobIdle };
+        std::atomic<int> busySlot { -1 };                       // case lue par le thread de fond
+    };
+
+    struct Stage
+    {
+        StageLayout layout {};
+        int index = 0, fftSize = 0, numBins = 0, capacity = 0, partitions = 0;
+
+        // Thread audio
+        std::array<std::vector<float>, kMaxChannels> accum, previous;
+        std::array<std::vector<float>, kMaxChannels> fdlRe, fdlIm;     // capacity + 1 cases
+        std::vector<int> window;        // case de X[k - p]: window[(newest - p) mod partitions]
+        int newest = 0, spare = 0;
+        int inFlight = -1;              // tâche due à la prochaine frontière
+        Scratch local;
+
+        // Au plus une tâche tourne sur l'unique thread de fond: l'une des deux est libre à chaque frontière
+        std::array<Job, 2> jobs;
+    };
+
+    enum EngineOwner { engineFree = 0, engineReady, engineAudio };
+
+    struct Engine
+    {
+        std::array<Stage, kNumStages> stages;
+        std::array<std::vector<float>, kMaxChannels> history, ring;
+        std::unique_ptr<const Kernel> kernel;
+        bool running = false;                           // thread audio
+
+        // Libre: au thread de fond; prêt: proposé au thread audio
+        std::atomic<int> owner { engineFree };
+    };
+
+    //==============================================================================
+    void allocateEngine (Engine&);
+    static void resetEngine (Engine&, std::unique_ptr<const Kernel>) noexcept;
+    juce::AudioBuffer<float> conformIr (const juce::AudioBuffer<float>& ir, double irSampleRate) const;
+    std::unique_ptr<Kernel> createKernel (const juce::AudioBuffer<float>& ir) const;
+    void buildPartition (Kernel&, const juce::AudioBuffer<float>& ir, int stage, int partition) noexcept;
+    std::unique_ptr<Kernel> buildKernel (const juce::AudioBuffer<float>& ir);
+    bool loadStep();
+
+    using ChunkBuffers = std::array<std::array<float, kHeadSize>, kMaxChannels>;
+
+    void beginBlock() noexcept;
+    void processChunk (int numChannels, int numSamples) noexcept;
+    void processEngine (Engine&, int numChannels, int numSamples, ChunkBuffers& out) noexcept;
+    void stageBoundary (Engine&, Stage&, int numChannels, juce::uint64 boundary) noexcept;
+    static bool computeJob (const Stage&, Job&, Scratch&, bool background) noexcept;
+    static void commit (Stage&, const Scratch&, int numChannels) noexcept;
+    static bool cancelJobs (Engine&) noexcept;
+
+    int useTimeSlice() override;
+
+    //==============================================================================
+    double sr = 0.0;
+    int maxIrLength = 0;
+
+    // Découpage fixé par prepare(); anneau ≥ plus grande sortie d'étage + pas interne
+    std::array<StageLayout, kNumStages> layout {};
+    int ringSize = 0;
+    const juce::uint32 gridPhase;       // décalage de grille propre à l'instance (fraction de 2^32)
+
+    std::array<Engine, 2> engines;
+    int active = 0;                     // moteur cible du dernier changement
+    int fadeRemaining = 0, fadeLength = 1;
+    juce::uint64 position = 0;          // échantillons traités (grille des étages, décalée)
+
+    // Tampons du pas interne (kHeadSize échantillons)
+    ChunkBuffers dry {}, wet {}, scratch {};
+
+    std::atomic<double> tailSeconds { 0.0 };
+
+    // RI demandée (thread message → thread de fond), gardée pour un changement de fréquence
+    juce::CriticalSection sourceLock;
+    juce::AudioBuffer<float> sourceIr;
+    double sourceIrRate = 0.0;
+    std::atomic<int> sourceSerial { 0 };
+
+    // Thread de fond: noyau en construction, une partition par tranche
+    struct Loader
+    {
+        std::unique_ptr<Kernel> kernel;
+        juce::AudioBuffer<float> ir;
+        std::array<std::unique_ptr<juce::dsp::FFT>, kNumStages> ffts;
+        std::vector<float> work;
+        int serial = 0, stage = 0, partition = 0;
+    };
+
+    Loader loader;
+
+    // Thread de fond partagé par toutes les instances
+    struct SharedThread : public juce::TimeSliceThread
+    {
+        SharedThread() : juce::TimeSliceThread ("Spectra Convolution") { startThread (juce::Thread::Priority::high); }
+        ~SharedThread() override { stopThread (2000); }
+    };
+
+    juce::SharedResourcePointer<SharedThread> thread;
+    bool registered = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PartitionedConvolver)
+};
+
+//==============================================================================
+template <typename Sample>
+void PartitionedConvolver::process (juce::AudioBuffer<Sample>& buffer, float mix) noexcept
+{
+    beginBlock();
+
+    if (! engines[0].running && ! engines[1].running)
+        return;
+
+    const int numChannels = juce::jmin (buffer.getNumChannels(), kMaxChannels);
+    const int numSamples  = buffer.getNumSamples();
+    mix = juce::jlimit (0.0f, 1.0f, mix);
+
+    // Pas interne aligné sur la grille de 64 échantillons (frontières des étages)
+    for (int done = 0; done < numSamples;)
+    {
+        const int n = juce::jmin (numSamples - done, kHeadSize - (int) (position % (juce::uint64) kHeadSize));
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto* x = buffer.getReadPointer (ch, done);
+            for (int i = 0; i < n; ++i)
+                dry[(size_t) ch][(size_t) i] = (float) x[i];
+        }
+
+        processChunk (numChannels, n);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* y = buffer.getWritePointer (ch, done);
+            const auto& d = dry[(size_t) ch];
+            const auto& w = wet[(size_t) ch];
+
+            for (int i = 0; i < n; ++i)
+                y[i] = (Sample) (d[(size_t) i] + mix * (w[(size_t) i] - d[(size_t) i]));
+        }
+
+        done += n;
+    }
+}
@@ -19,7 +19,8 @@ static inline int SX (float s, int v) { return (int) std::round (v * s); }
 void PluginAudioProcessorEditor::drawGoldenLight (juce::Graphics& g,
                                                   juce::Rectangle<float> around,
                                                   float intensity,
-                                                  juce::Rectangle<float> fullArea)
+                                                  juce::Rectangle<float> fullArea,
+                                                  const juce::Image& halo)
 {
     intensity = juce::jlimit (0.0f, 1.0f, intensity);
 
@@ -32,27 +33,22 @@ void PluginAudioProcessorEditor::drawGoldenLight (juce::Graphics& g,
     g.setColour (juce::Colour::fromRGB (255,230,150).withAlpha (0.12f * intensity));
     g.fillRect (fullArea);
 
-    // Noyau lumineux
-    const auto c0 = juce::Colour::fromRGB (255,250,210).withAlpha (0.98f * intensity);
-    const auto c1 = juce::Colour::fromRGB (255,236,160).withAlpha (0.75f * intensity);
-    const auto c2 = juce::Colour::fromRGB (255,220,120).withAlpha (0.34f * intensity);
-    const auto c3 = juce::Colour::fromRGB (255,220,120).withAlpha (0.00f);
-
-    juce::ColourGradient grad (c0, c.x, c.y, c3, c.x, c.y, true);
-    grad.addColour (0.00, c0);
-    grad.addColour (0.25, c1);
-    grad.addColour (0.70, c2);
-    grad.addColour (1.00, c3);
-
-    juce::Rectangle<float> halo (c.x - R, c.y - R, R*2.0f, R*2.0f);
-    g.setGradientFill (grad);
-    g.fillEllipse (halo);
+    // Noyau lumineux: halo précalculé (EditorAssets) étiré au rayon, opacité = intensité
+    if (halo.isValid() && R > 0.5f)
+    {
+        g.setOpacity (intensity);
+        g.drawImage (halo, juce::Rectangle<float> (c.x - R, c.y - R, R*2.0f, R*2.0f),
+                     juce::RectanglePlacement::stretchToFit);
+        g.setOpacity (1.0f);
+    }
 }
 
 //=============================================================================
-PluginAudioProcessorEditor::PluginAudioProcessorEditor (PluginAudioProcessor& p)
+PluginAudioProcessorEditor::PluginAudioProcessorEditor (PluginAudioProcessor& p, double openedAt)
     : AudioProcessorEditor (&p)
     , proc (p)
+    , assets ([this] (EditorAssets::Set::Ptr set) { applyAssets (set); })
+    , openedAtMs (openedAt)
 {
     setOpaque (true);
     setSize (kW, kH);
@@ -100,6 +96,59 @@ PluginAudioProcessorEditor::PluginAudioProcessorEditor (PluginAudioProcessor& p)
     addAndMakeVisible (meterIn);
     addAndMakeVisible (meterOut);
 
+    // Balistique: items dans l'ordre du paramètre "meterMode"
+    meterModeBox.addItemList (proc.parameters.getParameter ("meterMode")->getAllValueStrings(), 1);
+    addAndMakeVisible (meterModeBox);
+    meterModeAttach = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>
+        (proc.parameters, "meterMode", meterModeBox);
+
+    // Snapshots
+    for (int i = 0; i < SnapshotBank::kNumSlots; ++i)
+    {
+        auto& b = snapshotButtons[(size_t) i];
+        b.setButtonText (juce::String (i + 1));
+        b.setTooltip ("Click: recall / Shift+click: store");
+        b.setConnectedEdges ((i > 0 ? juce::Button::ConnectedOnLeft : 0)
+                           | (i < SnapshotBank::kNumSlots - 1 ? juce::Button::ConnectedOnRight : 0));
+        b.onClick = [this, i] { snapshotClicked (i); };
+        addAndMakeVisible (b);
+    }
+    updateSnapshotButtons();
+
+    morphTime.setSliderStyle (juce::Slider::LinearBar);
+    morphTime.setRange (0.0, 10.0, 0.01);
+    morphTime.setSkewFactorFromMidPoint (1.0);
+    morphTime.setTextValueSuffix (" s morph");
+    morphTime.setTooltip ("Recall morph time (0 = instant)");
+    morphTime.setValue (proc.getSnapshotMorphTime(), juce::dontSendNotification);
+    morphTime.onValueChange = [this] { proc.setSnapshotMorphTime (morphTime.getValue()); };
+    addAndMakeVisible (morphTime);
+
+    // Réponse impulsionnelle
+    irButton.onClick = [this] { showIrMenu(); };
+    addAndMakeVisible (irButton);
+    updateIrButton();
+
+    // Image stéréo: la FIFO s'est remplie éditeur fermé, ces points sont périmés
+    proc.getGoniometer().discardPending();
+    addAndMakeVisible (goniometer);
+    addAndMakeVisible (correlationMeter);
+
+    // Statistiques
+    statsReadout.setJustificationType (juce::Justification::centred);
+    statsReadout.setColour (juce::Label::textColourId, juce::Colours::white.withAlpha (0.6f));
+    statsReadout.setFont (statsReadout.getFont().withHeight (13.0f));
+    addAndMakeVisible (statsReadout);
+    updateStatsReadout();
+
+    statsResetButton.setTooltip ("Clear the histograms: start a new measurement");
+    statsResetButton.onClick = [this]
+    {
+        proc.getStatistics().reset();
+        updateStatsReadout();
+    };
+    addAndMakeVisible (statsResetButton);
+
     // Lien entre volume et luminosité
     gain.onValueChange = [this]
     {
@@ -130,13 +179,36 @@ void PluginAudioProcessorEditor::paint (juce::Graphics& g)
     // Halo global doré selon volume
     const float v = (float) gain.getValue();
     const float intensity = std::pow (v, 1.8f);
-    drawGoldenLight (g, gain.getBounds().toFloat(), intensity, area);
+    drawGoldenLight (g, gain.getBounds().toFloat(), intensity, area,
+                     assetSet != nullptr ? assetSet->halo : juce::Image());
 
-    // Titres
-    g.setFont (16.0f * s);
+    // Titres (mise en page précalculée si elle correspond à l'échelle courante)
     g.setColour (juce::Colours::white.withAlpha (0.85f));
-    g.drawFittedText ("IN",  SX (s, 40), SX (s, 356), SX (s, 40), SX (s, 20), juce::Justification::centredLeft, 1);
-    g.drawFittedText ("OUT", getWidth()/2 + SX (s, 80), SX (s, 356), SX (s, 40), SX (s, 20), juce::Justification::centredLeft, 1);
+    const int inX = SX (s, 40), outX = getWidth()/2 + SX (s, 80), labelY = SX (s, 356);
+
+    if (assetSet != nullptr && std::abs (assetSet->uiScale - s) < 0.001f)
+    {
+        assetSet->inLabel .draw (g, juce::AffineTransform::translation ((float) inX,  (float) labelY));
+        assetSet->outLabel.draw (g, juce::AffineTransform::translation ((float) outX, (float) labelY));
+    }
+    else
+    {
+        g.setFont (16.0f * s);
+        g.drawFittedText ("IN",  inX,  labelY, SX (s, 40), SX (s, 20), juce::Justification::centredLeft, 1);
+        g.drawFittedText ("OUT", outX, labelY, SX (s, 40), SX (s, 20), juce::Justification::centredLeft, 1);
+    }
+
+    // Temps d'ouverture: premier affichage, puis premier affichage complet
+    if (firstPaintMs < 0.0 || (fullFidelityMs < 0.0 && assetSet != nullptr))
+    {
+        const double elapsed = juce::Time::getMillisecondCounterHiRes() - openedAtMs;
+        if (firstPaintMs < 0.0)
+            firstPaintMs = elapsed;
+        if (assetSet != nullptr)
+            fullFidelityMs = elapsed;
+
+        proc.setEditorOpenTimes ((float) firstPaintMs, (float) fullFidelityMs);
+    }
 }
 
 //=============================================================================
@@ -161,6 +233,39 @@ void PluginAudioProcessorEditor::resized()
                         juce::jmax (SX (s,180), getWidth()/2 - SX (s,160)), SX (s,18));
     meterOut.setBounds (getWidth()/2 + SX (s,128),  getHeight() - SX (s,140),
                         juce::jmax (SX (s,180), getWidth()/2 - SX (s,168)), SX (s,18));
+
+    goniometer      .setBounds (SX (s, 60), SX (s, 130), SX (s, 160), SX (s, 160));
+    correlationMeter.setBounds (SX (s, 60), SX (s, 298), SX (s, 160), SX (s, 12));
+
+    meterModeBox.setBounds (getWidth() - SX (s, 220), SX (s, 130), SX (s, 160), SX (s, 24));
+    irButton    .setBounds (getWidth() - SX (s, 220), SX (s, 162), SX (s, 160), SX (s, 24));
+
+    const int slotW = SX (s, 160) / SnapshotBank::kNumSlots;
+    for (int i = 0; i < SnapshotBank::kNumSlots; ++i)
+        snapshotButtons[(size_t) i].setBounds (getWidth() - SX (s, 220) + i * slotW, SX (s, 194), slotW, SX (s, 24));
+    morphTime   .setBounds (getWidth() - SX (s, 220), SX (s, 222), SX (s, 160), SX (s, 20));
+
+    statsReadout    .setBounds (SX (s, 40), getHeight() - SX (s, 100), getWidth() - SX (s, 150), SX (s, 24));
+    statsResetButton.setBounds (getWidth() - SX (s, 100), getHeight() - SX (s, 100), SX (s, 60), SX (s, 24));
+
+    requestAssets();
+}
+
+//=============================================================================
+void PluginAudioProcessorEditor::requestAssets()
+{
+    const float s = uiScaleFor (*this);
+    const float pixelScale = juce::jlimit (1.0f, 3.0f, (float) juce::Component::getApproximateScaleFactorForComponent (this));
+    assets.request (s, SX (s, 180), pixelScale);
+}
+
+void PluginAudioProcessorEditor::applyAssets (EditorAssets::Set::Ptr set)
+{
+    assetSet = set;
+    knobLnf.setBodyFrames (set->knobFrames, set->knobFrameSize, set->pixelScale);
+    meterIn .setColourMap (set->levelColours);
+    meterOut.setColourMap (set->levelColours);
+    repaint();
 }
 
 //=============================================================================
@@ -169,5 +274,105 @@ void PluginAudioProcessorEditor::timerCallback()
     const float s = uiScaleFor (*this);
     meterIn .setLevel (proc.getInLevel());
     meterOut.setLevel (proc.getOutLevel());
+    correlationMeter.setCorrelation (proc.getCorrelation());
+    goniometer.update (proc.getGoniometer());
+
+    if (++statsTick >= 15)
+    {
+        statsTick = 0;
+        updateStatsReadout();
+        updateSnapshotButtons();     // programme changé par l'hôte
+
+        // Durée restaurée avec un état de l'hôte
+        if (! morphTime.isMouseButtonDown())
+            morphTime.setValue (proc.getSnapshotMorphTime(), juce::dontSendNotification);
+    }
     repaint (juce::Rectangle<int> (0, SX (s, 340), getWidth(), SX (s, 80)));
 }
+
+//=============================================================================
+void PluginAudioProcessorEditor::updateStatsReadout()
+{
+    using Stats = LevelStatistics;
+    const auto& st = proc.getStatistics();
+    const auto total = (int) st.getSeconds (Stats::peak);
+
+    juce::String text;
+    text << "ST LUFS  p10 " << juce::String (st.getQuantile (Stats::shortTermLoudness, 0.10), 1)
+         << "  p50 "        << juce::String (st.getQuantile (Stats::shortTermLoudness, 0.50), 1)
+         << "  p95 "        << juce::String (st.getQuantile (Stats::shortTermLoudness, 0.95), 1)
+         << "   |   Peak p99 " << juce::String (st.getQuantile (Stats::peak, 0.99), 1) << " dBFS"
+         << "   |   > -1 dBFS " << juce::String (st.getSecondsAbove (Stats::peak, -1.0f), 1) << " s"
+         << "   |   " << juce::String::formatted ("%d:%02d:%02d", total / 3600, (total / 60) % 60, total % 60);
+
+    statsReadout.setText (text, juce::dontSendNotification);
+}
+
+//=============================================================================
+void PluginAudioProcessorEditor::snapshotClicked (int slot)
+{
+    if (juce::ModifierKeys::currentModifiers.isShiftDown() || ! proc.hasSnapshot (slot))
+        proc.storeSnapshot (slot);
+    else
+        proc.recallSnapshot (slot);
+
+    updateSnapshotButtons();
+}
+
+void PluginAudioProcessorEditor::updateSnapshotButtons()
+{
+    const int current = proc.getCurrentProgram();
+
+    for (int i = 0; i < SnapshotBank::kNumSlots; ++i)
+    {
+        auto& b = snapshotButtons[(size_t) i];
+        const bool stored = proc.hasSnapshot (i);
+        b.setToggleState (stored && i == current, juce::dontSendNotification);
+        b.setColour (juce::TextButton::textColourOffId, juce::Colours::white.withAlpha (stored ? 0.9f : 0.35f));
+    }
+}
+
+//=============================================================================
+void PluginAudioProcessorEditor::updateIrButton()
+{
+    const auto file = proc.getImpulseResponseFile();
+    irButton.setButtonText (file == juce::File() ? juce::String ("IR: -") : "IR: " + file.getFileNameWithoutExtension());
+}
+
+void PluginAudioProcessorEditor::showIrMenu()
+{
+    juce::PopupMenu menu;
+    menu.addItem (1, "Load IR...");
+    menu.addItem (2, "Clear IR", proc.getImpulseResponseFile() != juce::File());
+
+    menu.showMenuAsync (juce::PopupMenu::Options().withTargetComponent (&irButton),
+                        [safe = juce::Component::SafePointer<PluginAudioProcessorEditor> (this)] (int result)
+    {
+        if (safe == nullptr)
+            return;
+
+        if (result == 2)
+        {
+            safe->proc.clearImpulseResponse();
+            safe->updateIrButton();
+            return;
+        }
+
+        if (result != 1)
+            return;
+
+        safe->irChooser = std::make_unique<juce::FileChooser> ("Impulse response", safe->proc.getImpulseResponseFile(), "*.wav;*.aif;*.aiff;*.flac");
+        safe->irChooser->launchAsync (juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                                      [safe] (const juce::FileChooser& chooser)
+        {
+            if (safe == nullptr)
+                return;
+
+            const auto file = chooser.getResult();
+            if (file.existsAsFile() && ! safe->proc.loadImpulseResponse (file))
+                juce::AlertWindow::showMessageBoxAsync (juce::MessageBoxIconType::WarningIcon, "Spectra",
+                                                        "Unreadable impulse response: " + file.getFileName());
+            safe->updateIrButton();
+        });
+    });
+}
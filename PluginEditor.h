@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "GoldenKnobLNF.h"
+#include "EditorAssets.h"
 
 // Barre de niveau linéaire 0..1
 class LinearMeter final : public juce::Component
@@ -16,17 +17,118 @@ public:
         repaint();
     }
 
+    // Palette 0..1 étirée sur toute la longueur (barre unie tant qu'elle est absente)
+    void setColourMap (const juce::Image& map)
+    {
+        colourMap = map;
+        repaint();
+    }
+
     void paint (juce::Graphics& g) override
     {
         auto r = getLocalBounds().toFloat();
         g.setColour (juce::Colour::fromRGB (18,18,20));  g.fillRoundedRectangle (r, 4.0f);
         g.setColour (juce::Colour::fromRGB (10,10,12));  g.fillRoundedRectangle (r.reduced (2), 4.0f);
-        auto f = r.reduced (3); f.setWidth (f.getWidth() * level);
-        g.setColour (juce::Colours::white.withAlpha (0.45f)); g.fillRoundedRectangle (f, 4.0f);
+
+        const auto track = r.reduced (3);
+        auto f = track; f.setWidth (f.getWidth() * level);
+
+        if (colourMap.isValid())
+        {
+            juce::Graphics::ScopedSaveState state (g);
+            juce::Path bar; bar.addRoundedRectangle (f, 4.0f);
+            g.reduceClipRegion (bar);
+            g.drawImage (colourMap, track, juce::RectanglePlacement::stretchToFit);
+        }
+        else
+        {
+            g.setColour (juce::Colours::white.withAlpha (0.45f)); g.fillRoundedRectangle (f, 4.0f);
+        }
     }
 
 private:
     float level = 0.0f;
+    juce::Image colourMap;
+};
+
+//==============================================================================
+// Barre de corrélation -1..+1 (centre = 0)
+class CorrelationMeter final : public juce::Component
+{
+public:
+    CorrelationMeter() = default;
+
+    void setCorrelation (float v) noexcept
+    {
+        v = juce::jlimit (-1.0f, 1.0f, v);
+        if (std::abs (v - value) < 0.002f) return;
+        value = v;
+        repaint();
+    }
+
+    void paint (juce::Graphics& g) override
+    {
+        auto r = getLocalBounds().toFloat();
+        g.setColour (juce::Colour::fromRGB (18,18,20));  g.fillRoundedRectangle (r, 3.0f);
+        g.setColour (juce::Colour::fromRGB (10,10,12));  g.fillRoundedRectangle (r.reduced (2), 3.0f);
+
+        auto f = r.reduced (3);
+        const float cx = f.getCentreX();
+        const float x  = cx + value * f.getWidth() * 0.5f;
+        auto bar = juce::Rectangle<float>::leftTopRightBottom (juce::jmin (cx, x), f.getY(),
+                                                               juce::jmax (cx, x), f.getBottom());
+        // Rouge en opposition de phase, blanc sinon
+        g.setColour ((value < 0.0f ? juce::Colour::fromRGB (230,80,60) : juce::Colours::white).withAlpha (0.55f));
+        g.fillRect (bar);
+        g.setColour (juce::Colours::white.withAlpha (0.25f));
+        g.drawVerticalLine ((int) cx, f.getY(), f.getBottom());
+    }
+
+private:
+    float value = 0.0f;
+};
+
+//==============================================================================
+// Goniomètre: nuage de points borné à kMaxPointsPerFrame par image
+class GoniometerView final : public juce::Component
+{
+public:
+    GoniometerView() : points ((size_t) GoniometerBuffer::kMaxPointsPerFrame) {}
+
+    void update (GoniometerBuffer& source)
+    {
+        numPoints = source.readLatest (points.data(), (int) points.size());
+        repaint();
+    }
+
+    void paint (juce::Graphics& g) override
+    {
+        auto r = getLocalBounds().toFloat();
+        g.setColour (juce::Colour::fromRGB (18,18,20));  g.fillRoundedRectangle (r, 4.0f);
+        g.setColour (juce::Colour::fromRGB (10,10,12));  g.fillRoundedRectangle (r.reduced (2), 4.0f);
+
+        const auto c = r.getCentre();
+        const float half = juce::jmin (r.getWidth(), r.getHeight()) * 0.5f - 4.0f;
+
+        // Repères: axes L/R et M/S
+        g.setColour (juce::Colours::white.withAlpha (0.10f));
+        g.drawLine (c.x - half, c.y, c.x + half, c.y);
+        g.drawLine (c.x, c.y - half, c.x, c.y + half);
+        g.drawLine (c.x - half * 0.7071f, c.y - half * 0.7071f, c.x + half * 0.7071f, c.y + half * 0.7071f);
+        g.drawLine (c.x - half * 0.7071f, c.y + half * 0.7071f, c.x + half * 0.7071f, c.y - half * 0.7071f);
+
+        g.setColour (juce::Colour::fromRGB (255,224,120).withAlpha (0.55f));
+        for (int i = 0; i < numPoints; ++i)
+        {
+            const float px = c.x + juce::jlimit (-1.0f, 1.0f, points[(size_t) i].x) * half;
+            const float py = c.y - juce::jlimit (-1.0f, 1.0f, points[(size_t) i].y) * half;
+            g.fillRect (px, py, 1.5f, 1.5f);
+        }
+    }
+
+private:
+    std::vector<juce::Point<float>> points;
+    int numPoints = 0;
 };
 
 //==============================================================================
@@ -35,11 +137,13 @@ class PluginAudioProcessorEditor final : public juce::AudioProcessorEditor,
                                          private juce::Timer
 {
 public:
-    explicit PluginAudioProcessorEditor (PluginAudioProcessor&);
+    // openedAtMs: horodatage pris par createEditor(), avant toute construction
+    PluginAudioProcessorEditor (PluginAudioProcessor&, double openedAtMs);
     ~PluginAudioProcessorEditor() override;
 
     void paint (juce::Graphics&) override;
     void resized() override;
+    void parentHierarchyChanged() override     { requestAssets(); }   // densité d'écran connue
 
     // Dimensions de référence + bornes de zoom
     static constexpr int   kW         = 820;
@@ -48,11 +152,12 @@ public:
     static constexpr float kMaxScale  = 1.75f;
 
 private:
-    // Halo doré puissant, sans anneau
+    // Halo doré puissant, sans anneau (voile seul tant que l'image n'est pas prête)
     static void drawGoldenLight (juce::Graphics& g,
                                  juce::Rectangle<float> around,
                                  float intensity,
-                                 juce::Rectangle<float> fullArea);
+                                 juce::Rectangle<float> fullArea,
+                                 const juce::Image& halo);
 
     // Référence processeur
     PluginAudioProcessor& proc;
@@ -68,6 +173,37 @@ private:
     juce::Label gainReadoutRight { "gainReadoutRight", "0.50" };
 
     LinearMeter meterIn, meterOut;
+    juce::ComboBox meterModeBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> meterModeAttach;
+
+    // Snapshots A/B: clic = rappel, Maj+clic (ou slot vide) = mémorisation
+    std::array<juce::TextButton, SnapshotBank::kNumSlots> snapshotButtons;
+    void snapshotClicked (int slot);
+    void updateSnapshotButtons();
+    juce::Slider morphTime;          // durée de morphing des rappels (sauvée avec la banque)
+
+    // Réponse impulsionnelle: chargement / retrait (le mélange reste un paramètre hôte)
+    juce::TextButton irButton;
+    std::unique_ptr<juce::FileChooser> irChooser;
+    void showIrMenu();
+    void updateIrButton();
+
+    CorrelationMeter correlationMeter;
+    GoniometerView   goniometer;
+
+    // Statistiques longue durée (rafraîchies ~2 Hz)
+    juce::Label statsReadout;
+    juce::TextButton statsResetButton { "Reset" };
+    int statsTick = 0;
+    void updateStatsReadout();
+
+    // Ressources graphiques préparées en arrière-plan + temps d'ouverture (ms)
+    EditorAssets assets;
+    EditorAssets::Set::Ptr assetSet;
+    const double openedAtMs;
+    double firstPaintMs = -1.0, fullFidelityMs = -1.0;
+    void applyAssets (EditorAssets::Set::Ptr);
+    void requestAssets();
 
     void timerCallback() override;
 
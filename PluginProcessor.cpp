@@ -1,19 +1,54 @@
 //============================== PluginProcessor.cpp ===============================
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "RealtimeGuard.h"
 #include <cmath>
+#include <utility>
+
+// Longueurs de mot proposées par "ditherBits" (index 0 = désactivé)
+static constexpr int kDitherBitDepths[] = { 0, 24, 20, 16 };
 
 //==============================================================================
 PluginAudioProcessor::PluginAudioProcessor()
     : AudioProcessor (BusesProperties()
                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-                      .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      parameters (*this, nullptr, "PARAMETERS", createParameterLayout())
+                      .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                      .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)),
+      parameters (*this, nullptr, "PARAMETERS", createParameterLayout()),
+      snapshots (parameters)
 {
-    gainParam = parameters.getRawParameterValue ("gain");
+    auto bind = [this] (const char* id) { return ParamRef { parameters.getRawParameterValue (id), snapshots.indexOf (id) }; };
+
+    gainParam     = bind ("gain");
+    duckThreshold = bind ("duckThreshold");
+    duckDepth     = bind ("duckDepth");
+    duckAttack    = bind ("duckAttack");
+    duckHold      = bind ("duckHold");
+    duckRelease   = bind ("duckRelease");
+    ditherBits    = bind ("ditherBits");
+    ditherShape   = bind ("ditherShape");
+    meterMode     = bind ("meterMode");
+    irMix         = bind ("irMix");
+
+    // Graine propre à l'instance: des dithers identiques sur N pistes s'additionnent
+    // de façon cohérente. Sauvée dans l'état, un rendu rechargé reste reproductible
+    setDitherSeed ((juce::uint32) juce::Random::getSystemRandom().nextInt());
+
+    // Trace opt-in sans UI: SPECTRA_TRACE=<dossier>, SPECTRA_TRACE_AUDIO=1 pour l'audio d'entrée
+    const auto traceDir = juce::SystemStats::getEnvironmentVariable ("SPECTRA_TRACE", {});
+    if (traceDir.isNotEmpty() && juce::File::isAbsolutePath (traceDir))
+    {
+        const auto name = "Spectra-" + juce::Time::getCurrentTime().formatted ("%Y%m%d-%H%M%S") + ".sptrace";
+        startTrace (juce::File (traceDir).getChildFile (name).getNonexistentSibling(),
+                    juce::SystemStats::getEnvironmentVariable ("SPECTRA_TRACE_AUDIO", {}) == "1");
+    }
 }
 
-PluginAudioProcessor::~PluginAudioProcessor() = default;
+PluginAudioProcessor::~PluginAudioProcessor()
+{
+    // Avant la destruction des paramètres lus par l'écrivain
+    trace.stop();
+}
 
 //==============================================================================
 juce::AudioProcessorValueTreeState::ParameterLayout PluginAudioProcessor::createParameterLayout()
@@ -23,6 +58,42 @@ juce::AudioProcessorValueTreeState::ParameterLayout PluginAudioProcessor::create
         "gain", "Gain",
         juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f, 1.0f),
         0.5f));
+
+    // Ducking sidechain
+    params.push_back (std::make_unique<juce::AudioParameterFloat> (
+        "duckThreshold", "Duck Threshold",
+        juce::NormalisableRange<float> (-60.0f, 0.0f, 0.1f), -30.0f));
+    params.push_back (std::make_unique<juce::AudioParameterFloat> (
+        "duckDepth", "Duck Depth",
+        juce::NormalisableRange<float> (-40.0f, 0.0f, 0.1f), -12.0f));
+    params.push_back (std::make_unique<juce::AudioParameterFloat> (
+        "duckAttack", "Duck Attack",
+        juce::NormalisableRange<float> (0.1f, 100.0f, 0.1f, 0.5f), 10.0f));
+    params.push_back (std::make_unique<juce::AudioParameterFloat> (
+        "duckHold", "Duck Hold",
+        juce::NormalisableRange<float> (0.0f, 1000.0f, 1.0f, 0.5f), 50.0f));
+    params.push_back (std::make_unique<juce::AudioParameterFloat> (
+        "duckRelease", "Duck Release",
+        juce::NormalisableRange<float> (10.0f, 2000.0f, 1.0f, 0.5f), 250.0f));
+
+    // Dither de sortie
+    params.push_back (std::make_unique<juce::AudioParameterChoice> (
+        "ditherBits", "Dither Bits",
+        juce::StringArray { "Off", "24 bits", "20 bits", "16 bits" }, 0));
+    params.push_back (std::make_unique<juce::AudioParameterChoice> (
+        "ditherShape", "Noise Shaping",
+        juce::StringArray { "TPDF", "First Order", "E-Weighted", "F-Weighted" }, 0));
+
+    // Balistique des mètres (ordre = MeterBallistics::Mode)
+    params.push_back (std::make_unique<juce::AudioParameterChoice> (
+        "meterMode", "Meter Ballistics",
+        juce::StringArray { "Digital Peak", "PPM Type I", "PPM Type II", "VU" }, 0));
+
+    // Convolution par RI (sans effet tant qu'aucune RI n'est chargée)
+    params.push_back (std::make_unique<juce::AudioParameterFloat> (
+        "irMix", "IR Mix",
+        juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
+
     return { params.begin(), params.end() };
 }
 
@@ -31,92 +102,299 @@ bool PluginAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) c
 {
     const auto& mainIn  = layouts.getChannelSet (true,  0);
     const auto& mainOut = layouts.getChannelSet (false, 0);
+
+    // Sidechain optionnel: absent, mono ou stéréo
+    if (layouts.inputBuses.size() > 1)
+    {
+        const auto& side = layouts.getChannelSet (true, 1);
+        if (! side.isDisabled() && side != juce::AudioChannelSet::mono() && side != juce::AudioChannelSet::stereo())
+            return false;
+    }
+
     return mainIn == mainOut && (! mainIn.isDisabled());
 }
 
+//==============================================================================
+void PluginAudioProcessor::setCurrentProgram (int index)
+{
+    // Hôtes qui renvoient le programme courant juste après setStateInformation:
+    // ne pas écraser les paramètres restaurés. Ensuite, re-rappeler le programme
+    // courant annule les retouches, comme l'attend le menu de l'hôte
+    if (std::exchange (programEchoPending, false) && index == snapshots.getCurrentSlot())
+        return;
+
+    trace.programChanged (index);
+    snapshots.recall (index);
+}
+
+void PluginAudioProcessor::storeSnapshot (int slot)
+{
+    programEchoPending = false;
+    snapshots.capture (slot);
+    updateHostDisplay (ChangeDetails().withProgramChanged (true));
+}
+
+bool PluginAudioProcessor::recallSnapshot (int slot)
+{
+    programEchoPending = false;
+    trace.programChanged (slot);
+
+    if (! snapshots.recall (slot))
+        return false;
+
+    updateHostDisplay (ChangeDetails().withProgramChanged (true));
+    return true;
+}
+
 //==============================================================================
 void PluginAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    juce::ignoreUnused (samplesPerBlock);
     sr = (sampleRate > 0.0 ? sampleRate : 48000.0);
-    inLevel = 0.0f;
-    outLevel = 0.0f;
+    inMeter .prepare (sr);
+    outMeter.prepare (sr);
+
+    snapshots.prepare (sr);
+    correlation.prepare (sr);
+    goniometer.prepare (sr);
+
+    outLoudness.prepare (sr);
+    loadMeasurer.reset (sr, samplesPerBlock);
+    statistics.prepare (sr);
+
+    ducker.prepare (sr, samplesPerBlock);
+    dither.prepare (samplesPerBlock);
+    convolver.prepare (sr, samplesPerBlock);
+
+    trace.prepared (sr, samplesPerBlock, getMainBusNumInputChannels(), getChannelCountOfBus (true, 1));
 }
 
 //==============================================================================
 // Gabarit processeur (float/double)
 template <typename Sample>
-void PluginAudioProcessor::processBlockT (juce::AudioBuffer<Sample>& buffer, juce::MidiBuffer&)
+void PluginAudioProcessor::processBlockT (juce::AudioBuffer<Sample>& hostBuffer, juce::MidiBuffer&)
 {
+    // Bus principal (entrée = sortie); le sidechain éventuel suit dans hostBuffer
+    auto buffer = getBusBuffer (hostBuffer, true, 0);
+
     const int numCh  = buffer.getNumChannels();
     const int numSm  = buffer.getNumSamples();
-    const float g = *gainParam;
+    const auto* snap = snapshots.beginBlock (numSm);
+    const float g = paramValue (snap, gainParam);
+
+    const auto mm = (MeterBallistics::Mode) juce::jlimit (0, MeterBallistics::kNumModes - 1,
+                                                          juce::roundToInt (paramValue (snap, meterMode)));
+    inMeter .setMode (mm);
+    outMeter.setMode (mm);
+    inMeter .process (buffer.getArrayOfReadPointers(), numCh, numSm);
 
-    float accIn = 0.0f;
-    float accOut = 0.0f;
+    // Image stéréo de l'entrée (avant traitement en place)
+    if (numCh > 0)
+    {
+        const auto* left  = buffer.getReadPointer (0);
+        const auto* right = buffer.getReadPointer (juce::jmin (1, numCh - 1));
+        correlation.process (left, right, numSm);
+        goniometer.push (left, right, numSm);
+    }
 
-    // Traitement linéaire 0..1 + moyenne absolue (échantillonnage adjacent)
+    // Traitement linéaire 0..1
     for (int ch = 0; ch < numCh; ++ch)
     {
-        auto* in  = buffer.getReadPointer  (ch);
         auto* out = buffer.getWritePointer (ch);
 
         for (int i = 0; i < numSm; ++i)
-        {
-            const float x = (float) in[i];
-            const float y = x * g;          // application linéaire
-            out[i] = (Sample) y;
+            out[i] = (Sample) ((float) out[i] * g);
+    }
 
-            accIn  += std::abs (x);
-            accOut += std::abs (y);
-        }
+    // Coloration par RI (tête directe: aucune latence ajoutée)
+    convolver.process (buffer, paramValue (snap, irMix));
+
+    // Ducking: uniquement si le sidechain est connecté (coût nul sinon)
+    if (getChannelCountOfBus (true, 1) > 0)
+    {
+        SidechainDucker::Settings ds;
+        ds.thresholdDb = paramValue (snap, duckThreshold);
+        ds.depthDb     = paramValue (snap, duckDepth);
+        ds.attackMs    = paramValue (snap, duckAttack);
+        ds.holdMs      = paramValue (snap, duckHold);
+        ds.releaseMs   = paramValue (snap, duckRelease);
+
+        ducker.process (buffer, getBusBuffer (hostBuffer, true, 1), ds);
+    }
+
+    // Réduction de longueur de mot: dernier étage avant la sortie
+    const int bitsIndex = juce::jlimit (0, 3, juce::roundToInt (paramValue (snap, ditherBits)));
+    if (bitsIndex > 0)
+    {
+        const auto shape = (OutputDither::Shape) juce::jlimit (0, 3, juce::roundToInt (paramValue (snap, ditherShape)));
+        dither.process (buffer, kDitherBitDepths[bitsIndex], shape);
+    }
+    else
+    {
+        // Bruit lié à la timeline: la position avance même dither coupé
+        dither.skip (numSm);
     }
 
-    const float denom = (float) (numSm * juce::jmax (1, numCh));
-    const float tIn  = juce::jlimit (0.0f, 1.0f, accIn  / denom);
-    const float tOut = juce::jlimit (0.0f, 1.0f, accOut / denom);
+    outMeter.process (buffer.getArrayOfReadPointers(), numCh, numSm);
+
+    // Sonie de sortie + publication télémétrie (sans attente)
+    outLoudness.process (buffer.getArrayOfReadPointers(), numCh, numSm);
 
-    // Lissage progressif pour affichage visuel stable
-    const float aUp   = 1.0f - std::exp (-8.0f  * (float) numSm / (float) sr);
-    const float aDown = 1.0f - std::exp (-1.2f * (float) numSm / (float) sr);
+    const float peak = numCh > 0 ? (float) buffer.getMagnitude (0, numSm) : 0.0f;
+    statistics.push (outLoudness.getShortTermLufs(), juce::Decibels::gainToDecibels (peak, -120.0f), numSm);
 
-    auto lerp = [] (float a, float b, float t) noexcept { return a + t * (b - a); };
-    inLevel  = tIn  > inLevel  ? lerp (inLevel,  tIn,  aUp) : lerp (inLevel,  tIn,  aDown);
-    outLevel = tOut > outLevel ? lerp (outLevel, tOut, aUp) : lerp (outLevel, tOut, aDown);
+    Telemetry::Payload t;
+    t.inLevel         = inMeter.getLevel();
+    t.outLevel        = outMeter.getLevel();
+    t.correlation     = correlation.getCorrelation();
+    t.momentaryLufs   = outLoudness.getMomentaryLufs();
+    t.shortTermLufs   = outLoudness.getShortTermLufs();
+    t.cpuLoad         = (float) loadMeasurer.getLoadAsProportion();
+    t.sampleRate      = sr;
+    t.blockSize       = numSm;
+    t.numChannels     = numCh;
+    t.blocksProcessed = ++blocksProcessed;
+    t.editorFirstPaintMs   = editorFirstPaintMs.load (std::memory_order_relaxed);
+    t.editorFullFidelityMs = editorFullFidelityMs.load (std::memory_order_relaxed);
+    telemetry.publish (t, sr, numSm);
 }
 
 //==============================================================================
 void PluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
 {
+    SPECTRA_RT_SCOPE;
     juce::ScopedNoDenormals noDenormals;
+    const TraceRecorder::ScopedBlock traced (trace, buffer, getTotalNumInputChannels());
+    juce::AudioProcessLoadMeasurer::ScopedTimer loadTimer (loadMeasurer, buffer.getNumSamples());
     processBlockT (buffer, midi);
 }
 
 void PluginAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midi)
 {
+    SPECTRA_RT_SCOPE;
     juce::ScopedNoDenormals noDenormals;
+    const TraceRecorder::ScopedBlock traced (trace, buffer, getTotalNumInputChannels());
+    juce::AudioProcessLoadMeasurer::ScopedTimer loadTimer (loadMeasurer, buffer.getNumSamples());
     processBlockT (buffer, midi);
 }
 
+//==============================================================================
+bool PluginAudioProcessor::loadImpulseResponse (const juce::File& file)
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (file));
+    if (reader == nullptr || reader->sampleRate <= 0.0 || reader->lengthInSamples <= 0)
+        return false;
+
+    // Au-delà de kMaxSeconds la RI serait tronquée: inutile de lire plus
+    const auto maxLength = (juce::int64) std::ceil (reader->sampleRate * PartitionedConvolver::kMaxSeconds);
+    const int length = (int) juce::jmin (reader->lengthInSamples, maxLength);
+    const int numChannels = (int) juce::jlimit (1u, (unsigned) PartitionedConvolver::kMaxChannels, reader->numChannels);
+
+    juce::AudioBuffer<float> ir (numChannels, length);
+    if (! reader->read (&ir, 0, length, 0, true, numChannels > 1))
+        return false;
+
+    setImpulseResponse (ir, reader->sampleRate);
+    irFile = file;
+    return true;
+}
+
+void PluginAudioProcessor::setImpulseResponse (const juce::AudioBuffer<float>& ir, double irSampleRate)
+{
+    convolver.setImpulseResponse (ir, irSampleRate);
+    irFile = juce::File();
+}
+
+void PluginAudioProcessor::clearImpulseResponse()
+{
+    convolver.clearImpulseResponse();
+    irFile = juce::File();
+}
+
+//==============================================================================
+bool PluginAudioProcessor::startTrace (const juce::File& file, bool captureAudio)
+{
+    file.getParentDirectory().createDirectory();
+
+    juce::MemoryBlock state;
+    getStateInformation (state);
+
+    if (! trace.start (file, *this, captureAudio, state))
+        return false;
+
+    // Démarrage en cours de lecture: la configuration courante ouvre la trace
+    if (getSampleRate() > 0.0)
+        trace.prepared (getSampleRate(), getBlockSize(), getMainBusNumInputChannels(), getChannelCountOfBus (true, 1));
+
+    return true;
+}
+
 //==============================================================================
 juce::AudioProcessorEditor* PluginAudioProcessor::createEditor()
 {
-    return new PluginAudioProcessorEditor (*this);
+    // Temps d'ouverture mesuré depuis ici: construction de l'éditeur comprise
+    return new PluginAudioProcessorEditor (*this, juce::Time::getMillisecondCounterHiRes());
 }
 
 //==============================================================================
 void PluginAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = parameters.copyState();
+    state.appendChild (snapshots.toValueTree(), nullptr);
+    state.appendChild (statistics.toValueTree(), nullptr);
+    state.setProperty ("ditherSeed", (juce::int64) ditherSeed, nullptr);
+    if (irFile != juce::File())
+        state.setProperty ("irFile", irFile.getFullPathName(), nullptr);
     std::unique_ptr<juce::XmlElement> xml (state.createXml());
     copyXmlToBinary (*xml, destData);
 }
 
 void PluginAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
+    trace.stateRestored (data, sizeInBytes);
+
     std::unique_ptr<juce::XmlElement> xml (getXmlFromBinary (data, sizeInBytes));
     if (xml != nullptr && xml->hasTagName (parameters.state.getType()))
-        parameters.replaceState (juce::ValueTree::fromXml (*xml));
+    {
+        auto state = juce::ValueTree::fromXml (*xml);
+
+        // Snapshots et statistiques ne font pas partie de l'arbre APVTS
+        auto bank = state.getChildWithName (SnapshotBank::stateType);
+        if (bank.isValid())
+        {
+            state.removeChild (bank, nullptr);
+            snapshots.fromValueTree (bank);
+            programEchoPending = true;
+        }
+
+        auto stats = state.getChildWithName (LevelStatistics::stateType);
+        if (stats.isValid())
+        {
+            state.removeChild (stats, nullptr);
+            statistics.fromValueTree (stats);
+        }
+
+        if (state.hasProperty ("ditherSeed"))
+            setDitherSeed ((juce::uint32) (juce::int64) state.getProperty ("ditherSeed"));
+
+        // RI référencée par chemin; fichier absent = pas de convolution
+        const juce::String irPath = state.getProperty ("irFile").toString();
+        state.removeProperty ("irFile", nullptr);
+
+        if (irPath.isNotEmpty() && juce::File::isAbsolutePath (irPath))
+        {
+            if (! loadImpulseResponse (juce::File (irPath)))
+                clearImpulseResponse();
+        }
+        else if (irFile != juce::File())
+        {
+            clearImpulseResponse();
+        }
+
+        parameters.replaceState (state);
+    }
 }
 
 //==============================================================================
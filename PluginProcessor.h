@@ -1,14 +1,31 @@
 //============================== PluginProcessor.h ===============================
 #pragma once
 #include <JuceHeader.h>
+#include "StereoAnalysis.h"
+#include "ParameterSnapshots.h"
+#include "LoudnessMeter.h"
+#include "TelemetryExport.h"
+#include "LevelStatistics.h"
+#include "SidechainDucker.h"
+#include "OutputDither.h"
+#include "MeterBallistics.h"
+#include "PartitionedConvolver.h"
+#include "TraceRecorder.h"
+#include "EditorAssets.h"
 
 // Déclaration anticipée de l'éditeur
 class PluginAudioProcessorEditor;
 
 /**
  * Processeur audio principal.
- * Paramètre unique: "gain" (0..1, linéaire).
- * Expose niveaux IN/OUT lissés pour l'UI.
+ * Paramètres: "gain" (0..1, linéaire) + ducking piloté par le bus sidechain optionnel.
+ * Coloration optionnelle par RI (pièce/baffle) juste après le gain, sans latence.
+ * Étage de sortie: dither TPDF reproductible + mise en forme du bruit.
+ * Programmes = snapshots de paramètres (rappel sans verrou, morphing optionnel).
+ * Expose niveaux IN/OUT (balistique PPM/VU au choix), corrélation et goniomètre pour l'UI.
+ * Publie niveaux, sonie et charge CPU dans la télémétrie partagée.
+ * Statistiques longue durée (quantiles de sonie/crête) persistées dans l'état.
+ * Trace binaire optionnelle des appels hôte (SPECTRA_TRACE=<dossier>), rejouée par SpectraBench.
  */
 class PluginAudioProcessor final : public juce::AudioProcessor
 {
@@ -22,14 +39,14 @@ public:
     bool acceptsMidi() const override                                  { return false; }
     bool producesMidi() const override                                 { return false; }
     bool isMidiEffect() const override                                 { return false; }
-    double getTailLengthSeconds() const override                       { return 0.0; }
+    double getTailLengthSeconds() const override                       { return convolver.getTailSeconds(); }
 
-    // Programmes (non utilisés)
-    int getNumPrograms() override                                      { return 1; }
-    int getCurrentProgram() override                                   { return 0; }
-    void setCurrentProgram (int) override                              {}
-    const juce::String getProgramName (int) override                   { return {}; }
-    void changeProgramName (int, const juce::String&) override         {}
+    // Programmes = slots de snapshots
+    int getNumPrograms() override                                      { return SnapshotBank::kNumSlots; }
+    int getCurrentProgram() override                                   { return snapshots.getCurrentSlot(); }
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override             { return snapshots.getSlotName (index); }
+    void changeProgramName (int index, const juce::String& name) override { snapshots.setSlotName (index, name); }
 
     //==============================================================================
     // Préparation / audio
@@ -55,23 +72,119 @@ public:
     // Paramètres exposés à l'UI
     juce::AudioProcessorValueTreeState parameters;
 
-    // Accès mètres lissés pour l'éditeur
-    float getInLevel()  const noexcept { return inLevel;  }
-    float getOutLevel() const noexcept { return outLevel; }
+    // Accès mètres (balistique "meterMode") pour l'éditeur
+    float getInLevel()  const noexcept { return inMeter.getLevel();  }
+    float getOutLevel() const noexcept { return outMeter.getLevel(); }
+
+    // Image stéréo de l'entrée
+    float getCorrelation() const noexcept           { return correlation.getCorrelation(); }
+    GoniometerBuffer& getGoniometer() noexcept      { return goniometer; }
+
+    // Sonie de sortie (LUFS) et charge du callback (0..1)
+    float getShortTermLufs() const noexcept         { return outLoudness.getShortTermLufs(); }
+    float getCpuLoad() const noexcept               { return (float) loadMeasurer.getLoadAsProportion(); }
+
+    // Distribution longue durée des niveaux de sortie
+    LevelStatistics& getStatistics() noexcept       { return statistics; }
+
+    // Snapshots (thread message)
+    void storeSnapshot (int slot);
+    bool hasSnapshot (int slot) const noexcept              { return snapshots.hasSnapshot (slot); }
+    bool recallSnapshot (int slot);
+
+    // Durée de morphing des rappels (éditeur ou hôte), sauvée avec la banque
+    void   setSnapshotMorphTime (double seconds) noexcept   { snapshots.setMorphTime (seconds); }
+    double getSnapshotMorphTime() const noexcept            { return snapshots.getMorphTime(); }
+
+    // Temps d'ouverture de l'éditeur (ms, -1 = pas encore mesuré), publiés en télémétrie
+    void setEditorOpenTimes (float firstPaintMs, float fullFidelityMs) noexcept
+    {
+        editorFirstPaintMs.store (firstPaintMs, std::memory_order_relaxed);
+        editorFullFidelityMs.store (fullFidelityMs, std::memory_order_relaxed);
+    }
+
+    // Réponse impulsionnelle (thread message): changement sans coupure, fichier mémorisé dans l'état
+    bool loadImpulseResponse (const juce::File& file);
+    void setImpulseResponse (const juce::AudioBuffer<float>& ir, double irSampleRate);
+    void clearImpulseResponse();
+    juce::File getImpulseResponseFile() const                { return irFile; }
+
+    // Trace des appels hôte (thread message): fichier rejouable par SpectraBench
+    bool startTrace (const juce::File& file, bool captureAudio);
+    void stopTrace()                                        { trace.stop(); }
+    bool isTracing() const noexcept                         { return trace.isRecording(); }
+
+    // Graine du dither (rendus hors ligne identiques à graine égale)
+    void setDitherSeed (juce::uint32 seed) noexcept         { ditherSeed = seed; dither.setSeed (seed); }
 
     // Fabrique de layout des paramètres
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
 private:
-    // Lissage mètres (exp)
     double sr = 48000.0;
-    float  inLevel  = 0.0f;
-    float  outLevel = 0.0f;
+
+    // Mètres IN/OUT: détecteurs par échantillon, indépendants de la taille de bloc
+    MeterBallistics inMeter, outMeter;
+
+    // Analyse stéréo de l'entrée
+    StereoCorrelationMeter correlation;
+    GoniometerBuffer       goniometer;
+
+    // Sonie de sortie, charge CPU et export télémétrie
+    LoudnessMeter outLoudness;
+    juce::AudioProcessLoadMeasurer loadMeasurer;
+    TelemetryExporter telemetry;
+    juce::uint64 blocksProcessed = 0;
+    std::atomic<float> editorFirstPaintMs { -1.0f }, editorFullFidelityMs { -1.0f };
+
+    // Quantiles / temps au-dessus du seuil (intégrés hors thread audio)
+    LevelStatistics statistics;
+
+    // Snapshots précompilés
+    SnapshotBank snapshots;
+    bool programEchoPending = false;     // setStateInformation vient de restaurer le slot courant
+
+    // Paramètre: valeur brute APVTS + index dans Snapshot::values
+    struct ParamRef
+    {
+        std::atomic<float>* raw = nullptr;
+        int index = -1;
+    };
 
     // Cache pointeur sur le paramètre "gain" (0..1)
-    std::atomic<float>* gainParam = nullptr;
+    ParamRef gainParam;
+
+    // Ducking sidechain
+    ParamRef duckThreshold, duckDepth, duckAttack, duckHold, duckRelease;
+    SidechainDucker ducker;
+
+    // Réduction de longueur de mot en sortie
+    ParamRef ditherBits, ditherShape;
+    OutputDither dither;
+    juce::uint32 ditherSeed = OutputDither::kDefaultSeed;
+
+    // Balistique des mètres
+    ParamRef meterMode;
+
+    // Convolution par RI (mélange sec/convolué)
+    ParamRef irMix;
+    PartitionedConvolver convolver;
+    juce::File irFile;
+
+    // Trace des appels hôte (inactive par défaut)
+    TraceRecorder trace;
+
+    // Cache des ressources de l'éditeur, conservé entre deux ouvertures
+    EditorAssets::KeepAlive editorAssetCache;
+
+    // Valeur effective: snapshot en cours de morphing, sinon paramètre hôte
+    static float paramValue (const SnapshotBank::Snapshot* snap, const ParamRef& p) noexcept
+    {
+        return snap != nullptr && p.index >= 0 ? snap->values[(size_t) p.index]
+                                               : p.raw->load (std::memory_order_relaxed);
+    }
 
-    // Mesure moyenne absolue par bloc
+    // Traitement + mesures (float/double)
     template <typename Sample>
     void processBlockT (juce::AudioBuffer<Sample>&, juce::MidiBuffer&);
 
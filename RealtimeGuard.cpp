@@ -0,0 +1,473 @@
+//============================== RealtimeGuard.cpp ===============================
+#include "RealtimeGuard.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <execinfo.h>
+#endif
+
+#if SPECTRA_RT_GUARD && JUCE_WINDOWS
+ #include <malloc.h>
+#endif
+
+#if SPECTRA_RT_GUARD && JUCE_LINUX
+ #include <dlfcn.h>
+ #include <malloc.h>
+ #include <pthread.h>
+ #include <semaphore.h>
+ #include <time.h>
+ #include <unistd.h>
+#endif
+
+namespace RealtimeGuard
+{
+    // Profondeur du scope audio et garde de réentrance (thread courant)
+    static thread_local int  audioDepth = 0;
+    static thread_local bool reporting  = false;
+
+    static std::atomic<Mode> mode { Mode::record };
+    static std::atomic<int>  numViolations { 0 };
+    static Record            records[kMaxRecords];
+    static std::atomic<bool> recordReady[kMaxRecords];
+
+    static int captureFrames (void** frames, int maxFrames) noexcept
+    {
+       #if JUCE_LINUX || JUCE_MAC
+        return backtrace (frames, maxFrames);
+       #else
+        juce::ignoreUnused (frames, maxFrames);
+        return 0;
+       #endif
+    }
+
+    // backtrace() charge libgcc au premier appel: on le fait hors audio
+    [[maybe_unused]] static const bool initialised = []
+    {
+        void* warmUp[2];
+        captureFrames (warmUp, 2);
+
+        if (const char* env = std::getenv ("SPECTRA_RT_GUARD_ABORT"))
+            if (env[0] == '1')
+                mode.store (Mode::abort);
+
+        return true;
+    }();
+
+    static const char* violationName (Violation v) noexcept
+    {
+        switch (v)
+        {
+            case Violation::allocation:    return "allocation";
+            case Violation::deallocation:  return "deallocation";
+            case Violation::mutexLock:     return "mutex";
+            case Violation::blockingCall:  return "appel bloquant";
+        }
+
+        return "?";
+    }
+
+    //==============================================================================
+    void setMode (Mode m) noexcept      { mode.store (m); }
+    Mode getMode() noexcept             { return mode.load(); }
+
+    int getNumViolations() noexcept     { return numViolations.load(); }
+
+    bool getViolation (int index, Record& dest) noexcept
+    {
+        if (! juce::isPositiveAndBelow (index, juce::jmin (kMaxRecords, numViolations.load()))
+             || ! recordReady[index].load (std::memory_order_acquire))
+            return false;
+
+        dest = records[index];
+        return true;
+    }
+
+    void clearViolations() noexcept
+    {
+        for (auto& r : recordReady)
+            r.store (false);
+
+        numViolations.store (0);
+    }
+
+    juce::String describe (const Record& r)
+    {
+        juce::String s;
+        s << "[RT] " << violationName (r.kind) << " dans le callback audio: "
+          << (r.function != nullptr ? r.function : "?") << juce::newLine;
+
+       #if JUCE_LINUX || JUCE_MAC
+        if (r.numFrames > 0)
+            if (char** symbols = backtrace_symbols (r.frames, r.numFrames))
+            {
+                for (int i = 0; i < r.numFrames; ++i)
+                    s << "    " << symbols[i] << juce::newLine;
+
+                std::free (symbols);
+            }
+       #endif
+
+        return s;
+    }
+
+    //==============================================================================
+    bool isInsideAudioCallback() noexcept
+    {
+        return audioDepth > 0 && ! reporting;
+    }
+
+    void report (Violation kind, const char* function) noexcept
+    {
+        if (! isInsideAudioCallback())
+            return;
+
+        reporting = true;
+
+        if (mode.load() == Mode::abort)
+        {
+            const auto trace = juce::SystemStats::getStackBacktrace();
+            std::fprintf (stderr, "[RT] %s dans le callback audio: %s\n%s\n",
+                          violationName (kind), function, trace.toRawUTF8());
+            std::fflush (stderr);
+            std::abort();
+        }
+
+        // Enregistrement sans allocation dans un tableau fixe
+        const int index = numViolations.fetch_add (1);
+        if (index < kMaxRecords)
+        {
+            auto& r = records[index];
+            r.kind      = kind;
+            r.function  = function;
+            r.numFrames = captureFrames (r.frames, kMaxFrames);
+            recordReady[index].store (true, std::memory_order_release);
+        }
+
+        reporting = false;
+    }
+
+    //==============================================================================
+    ScopedAudioCallback::ScopedAudioCallback() noexcept    { ++audioDepth; }
+    ScopedAudioCallback::~ScopedAudioCallback() noexcept   { --audioDepth; }
+}
+
+//==============================================================================
+#if SPECTRA_RT_GUARD
+
+#if JUCE_LINUX
+//==============================================================================
+// Allocateur C (malloc & co.): HeapBlock, AudioBuffer::setSize, MemoryBlock et
+// String passent par std::malloc sans jamais toucher operator new.
+namespace
+{
+    struct RealAllocator
+    {
+        void* (*malloc)  (size_t) = nullptr;
+        void* (*calloc)  (size_t, size_t) = nullptr;
+        void* (*realloc) (void*, size_t) = nullptr;
+        void  (*free)    (void*) = nullptr;
+        int   (*posixMemalign) (void**, size_t, size_t) = nullptr;
+        void* (*alignedAlloc)  (size_t, size_t) = nullptr;
+        void* (*memalign)      (size_t, size_t) = nullptr;
+    };
+
+    RealAllocator realFns;
+    std::atomic<int> resolveState { 0 };     // 0 = à faire, 1 = en cours, 2 = prêt
+
+    // dlsym() alloue lui-même: ces allocations-là viennent d'une réserve statique
+    alignas (16) char bootstrap[64 * 1024];
+    std::atomic<size_t> bootstrapUsed { 0 };
+
+    bool isBootstrap (const void* p) noexcept
+    {
+        return p >= bootstrap && p < bootstrap + sizeof (bootstrap);
+    }
+
+    void* bootstrapAlloc (size_t n) noexcept
+    {
+        n = (n + 15) & ~(size_t) 15;
+        const size_t offset = bootstrapUsed.fetch_add (n);
+        return offset + n <= sizeof (bootstrap) ? bootstrap + offset : nullptr;   // zéros: jamais réutilisé
+    }
+
+    // Sans garde statique (qui prendrait un verrou), comme les interceptions pthread
+    bool resolveAllocator() noexcept
+    {
+        if (resolveState.load (std::memory_order_acquire) == 2)
+            return true;
+
+        int expected = 0;
+        if (! resolveState.compare_exchange_strong (expected, 1))
+            return false;
+
+        realFns.malloc        = reinterpret_cast<void* (*) (size_t)>         (dlsym (RTLD_NEXT, "malloc"));
+        realFns.calloc        = reinterpret_cast<void* (*) (size_t, size_t)> (dlsym (RTLD_NEXT, "calloc"));
+        realFns.realloc       = reinterpret_cast<void* (*) (void*, size_t)>  (dlsym (RTLD_NEXT, "realloc"));
+        realFns.free          = reinterpret_cast<void  (*) (void*)>          (dlsym (RTLD_NEXT, "free"));
+        realFns.posixMemalign = reinterpret_cast<int   (*) (void**, size_t, size_t)> (dlsym (RTLD_NEXT, "posix_memalign"));
+        realFns.alignedAlloc  = reinterpret_cast<void* (*) (size_t, size_t)> (dlsym (RTLD_NEXT, "aligned_alloc"));
+        realFns.memalign      = reinterpret_cast<void* (*) (size_t, size_t)> (dlsym (RTLD_NEXT, "memalign"));
+
+        resolveState.store (2, std::memory_order_release);
+        return true;
+    }
+
+    // Chemins sans signalement, pour operator new/delete (déjà signalés)
+    void* rawMalloc (size_t n) noexcept                 { return resolveAllocator() ? realFns.malloc (n) : bootstrapAlloc (n); }
+    void  rawFree (void* p) noexcept                    { if (p != nullptr && ! isBootstrap (p) && resolveAllocator()) realFns.free (p); }
+
+    void* rawAlignedAlloc (size_t align, size_t n) noexcept
+    {
+        void* p = nullptr;
+        if (resolveAllocator())
+            return realFns.posixMemalign (&p, juce::jmax (align, sizeof (void*)), n) == 0 ? p : nullptr;
+
+        return bootstrapAlloc (n + align);  // réserve alignée sur 16: seulement pendant la résolution
+    }
+}
+
+extern "C" void* malloc (size_t n) noexcept
+{
+    if (! resolveAllocator())
+        return bootstrapAlloc (n);
+
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "malloc");
+    return realFns.malloc (n);
+}
+
+extern "C" void* calloc (size_t count, size_t size) noexcept
+{
+    if (! resolveAllocator())
+        return bootstrapAlloc (count * size);
+
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "calloc");
+    return realFns.calloc (count, size);
+}
+
+extern "C" void* realloc (void* p, size_t n) noexcept
+{
+    if (! resolveAllocator())
+        return nullptr;
+
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "realloc");
+
+    // Bloc de la réserve: copie vers le vrai tas (taille d'origine inconnue, bornée par la réserve)
+    if (isBootstrap (p))
+    {
+        void* q = realFns.malloc (n);
+        if (q != nullptr)
+            std::memcpy (q, p, juce::jmin (n, (size_t) (bootstrap + sizeof (bootstrap) - static_cast<char*> (p))));
+
+        return q;
+    }
+
+    return realFns.realloc (p, n);
+}
+
+extern "C" void free (void* p) noexcept
+{
+    if (p == nullptr || isBootstrap (p) || ! resolveAllocator())
+        return;
+
+    RealtimeGuard::report (RealtimeGuard::Violation::deallocation, "free");
+    realFns.free (p);
+}
+
+extern "C" int posix_memalign (void** dest, size_t align, size_t n) noexcept
+{
+    if (! resolveAllocator())
+        return (*dest = bootstrapAlloc (n + align)) != nullptr ? 0 : 12 /* ENOMEM */;
+
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "posix_memalign");
+    return realFns.posixMemalign (dest, align, n);
+}
+
+extern "C" void* aligned_alloc (size_t align, size_t n) noexcept
+{
+    if (! resolveAllocator())
+        return bootstrapAlloc (n + align);
+
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "aligned_alloc");
+    return realFns.alignedAlloc (align, n);
+}
+
+extern "C" void* memalign (size_t align, size_t n) noexcept
+{
+    if (! resolveAllocator())
+        return bootstrapAlloc (n + align);
+
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "memalign");
+    return realFns.memalign (align, n);
+}
+
+#else
+namespace
+{
+    void* rawMalloc (size_t n) noexcept     { return std::malloc (n); }
+    void  rawFree (void* p) noexcept        { std::free (p); }
+
+    void* rawAlignedAlloc (size_t align, size_t n) noexcept
+    {
+       #if JUCE_WINDOWS
+        return _aligned_malloc (n, align);
+       #else
+        void* p = nullptr;
+        return posix_memalign (&p, juce::jmax (align, sizeof (void*)), n) == 0 ? p : nullptr;
+       #endif
+    }
+}
+#endif // JUCE_LINUX
+
+namespace
+{
+    void rawAlignedFree (void* p) noexcept
+    {
+       #if JUCE_WINDOWS
+        _aligned_free (p);
+       #else
+        rawFree (p);
+       #endif
+    }
+}
+
+//==============================================================================
+// Allocations C++ (remplacement global, sur l'allocateur C sans double signalement)
+void* operator new (std::size_t n)
+{
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "operator new");
+    if (void* p = rawMalloc (n != 0 ? n : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t n)
+{
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "operator new[]");
+    if (void* p = rawMalloc (n != 0 ? n : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new (std::size_t n, const std::nothrow_t&) noexcept
+{
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "operator new");
+    return rawMalloc (n != 0 ? n : 1);
+}
+
+void* operator new[] (std::size_t n, const std::nothrow_t&) noexcept
+{
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "operator new[]");
+    return rawMalloc (n != 0 ? n : 1);
+}
+
+void operator delete (void* p) noexcept
+{
+    if (p != nullptr)
+        RealtimeGuard::report (RealtimeGuard::Violation::deallocation, "operator delete");
+
+    rawFree (p);
+}
+
+void operator delete[] (void* p) noexcept
+{
+    if (p != nullptr)
+        RealtimeGuard::report (RealtimeGuard::Violation::deallocation, "operator delete[]");
+
+    rawFree (p);
+}
+
+void operator delete (void* p, std::size_t) noexcept     { operator delete (p); }
+void operator delete[] (void* p, std::size_t) noexcept   { operator delete[] (p); }
+
+// Surcharges alignées (alignas > alignement par défaut, ex. types SIMD)
+void* operator new (std::size_t n, std::align_val_t a)
+{
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "operator new (aligned)");
+    if (void* p = rawAlignedAlloc ((size_t) a, n != 0 ? n : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t n, std::align_val_t a)
+{
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "operator new[] (aligned)");
+    if (void* p = rawAlignedAlloc ((size_t) a, n != 0 ? n : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new (std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept
+{
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "operator new (aligned)");
+    return rawAlignedAlloc ((size_t) a, n != 0 ? n : 1);
+}
+
+void* operator new[] (std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept
+{
+    RealtimeGuard::report (RealtimeGuard::Violation::allocation, "operator new[] (aligned)");
+    return rawAlignedAlloc ((size_t) a, n != 0 ? n : 1);
+}
+
+void operator delete (void* p, std::align_val_t) noexcept
+{
+    if (p != nullptr)
+        RealtimeGuard::report (RealtimeGuard::Violation::deallocation, "operator delete (aligned)");
+
+    rawAlignedFree (p);
+}
+
+void operator delete[] (void* p, std::align_val_t) noexcept
+{
+    if (p != nullptr)
+        RealtimeGuard::report (RealtimeGuard::Violation::deallocation, "operator delete[] (aligned)");
+
+    rawAlignedFree (p);
+}
+
+void operator delete (void* p, std::size_t, std::align_val_t a) noexcept     { operator delete (p, a); }
+void operator delete[] (void* p, std::size_t, std::align_val_t a) noexcept   { operator delete[] (p, a); }
+
+//==============================================================================
+#if JUCE_LINUX
+
+// Résolution paresseuse du symbole suivant, sans garde statique (qui prendrait un verrou)
+#define SPECTRA_RT_INTERPOSE(ret, name, kind, params, args)                                 \
+    extern "C" ret name params                                                              \
+    {                                                                                       \
+        using Fn = ret (*) params;                                                          \
+        static std::atomic<Fn> real { nullptr };                                            \
+        Fn fn = real.load (std::memory_order_relaxed);                                      \
+        if (fn == nullptr)                                                                  \
+        {                                                                                   \
+            fn = reinterpret_cast<Fn> (dlsym (RTLD_NEXT, #name));                           \
+            real.store (fn, std::memory_order_relaxed);                                     \
+        }                                                                                   \
+        RealtimeGuard::report (RealtimeGuard::Violation::kind, #name);                      \
+        return fn args;                                                                     \
+    }
+
+SPECTRA_RT_INTERPOSE (int, pthread_mutex_lock,     mutexLock,    (pthread_mutex_t* m),  (m))
+SPECTRA_RT_INTERPOSE (int, pthread_rwlock_rdlock,  mutexLock,    (pthread_rwlock_t* l), (l))
+SPECTRA_RT_INTERPOSE (int, pthread_rwlock_wrlock,  mutexLock,    (pthread_rwlock_t* l), (l))
+SPECTRA_RT_INTERPOSE (int, pthread_cond_wait,      blockingCall, (pthread_cond_t* c, pthread_mutex_t* m), (c, m))
+SPECTRA_RT_INTERPOSE (int, pthread_cond_timedwait, blockingCall, (pthread_cond_t* c, pthread_mutex_t* m, const struct timespec* t), (c, m, t))
+SPECTRA_RT_INTERPOSE (int, sem_wait,               blockingCall, (sem_t* s), (s))
+SPECTRA_RT_INTERPOSE (int, nanosleep,              blockingCall, (const struct timespec* a, struct timespec* b), (a, b))
+SPECTRA_RT_INTERPOSE (int, usleep,                 blockingCall, (useconds_t u), (u))
+SPECTRA_RT_INTERPOSE (unsigned int, sleep,         blockingCall, (unsigned int s), (s))
+SPECTRA_RT_INTERPOSE (ssize_t, read,               blockingCall, (int fd, void* buf, size_t n), (fd, buf, n))
+SPECTRA_RT_INTERPOSE (ssize_t, write,              blockingCall, (int fd, const void* buf, size_t n), (fd, buf, n))
+SPECTRA_RT_INTERPOSE (int, fsync,                  blockingCall, (int fd), (fd))
+
+#undef SPECTRA_RT_INTERPOSE
+
+#endif // JUCE_LINUX
+#endif // SPECTRA_RT_GUARD
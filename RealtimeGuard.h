@@ -0,0 +1,82 @@
+//============================== RealtimeGuard.h ===============================
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ * Détecteur de violations temps-réel dans le callback audio (debug, opt-in).
+ *
+ * Compilé avec SPECTRA_RT_GUARD=1, le scope marqué par SPECTRA_RT_SCOPE
+ * intercepte allocations (operator new/delete, y compris alignés; malloc,
+ * calloc, realloc, free et variantes alignées sous Linux), prises de mutex
+ * et appels système bloquants. Chaque violation est enregistrée (pile brute, sans
+ * allocation) ou provoque un abort avec pile symbolisée.
+ *
+ * Mode par défaut: enregistrement. SPECTRA_RT_GUARD_ABORT=1 dans
+ * l'environnement bascule en abort, pour faire échouer un exécutable de
+ * test ou de benchmark au premier écart. SpectraBench, compilé avec le
+ * garde, sort en erreur si une violation a été relevée.
+ *
+ * Les interceptions de l'allocateur C, pthread et appels système (Linux) ne sont effectives que
+ * si ce fichier est lié dans l'exécutable (tests, bench, standalone): un
+ * plugin chargé par dlopen ne voit que operator new/delete.
+ */
+#ifndef SPECTRA_RT_GUARD
+ #define SPECTRA_RT_GUARD 0
+#endif
+
+namespace RealtimeGuard
+{
+    enum class Violation
+    {
+        allocation,
+        deallocation,
+        mutexLock,
+        blockingCall
+    };
+
+    enum class Mode
+    {
+        record,
+        abort
+    };
+
+    static constexpr int kMaxFrames  = 32;
+    static constexpr int kMaxRecords = 64;
+
+    struct Record
+    {
+        Violation   kind = Violation::allocation;
+        const char* function = nullptr;     // littéral statique
+        int         numFrames = 0;
+        void*       frames[kMaxFrames] {};
+    };
+
+    void setMode (Mode) noexcept;
+    Mode getMode() noexcept;
+
+    // Thread quelconque, hors audio: lecture / symbolisation des violations
+    int  getNumViolations() noexcept;
+    bool getViolation (int index, Record& dest) noexcept;
+    void clearViolations() noexcept;
+    juce::String describe (const Record&);
+
+    // Appelé par les interceptions; sans effet hors du scope audio
+    bool isInsideAudioCallback() noexcept;
+    void report (Violation, const char* function) noexcept;
+
+    // Marque la portée du callback audio (réentrant)
+    class ScopedAudioCallback
+    {
+    public:
+        ScopedAudioCallback() noexcept;
+        ~ScopedAudioCallback() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedAudioCallback)
+    };
+}
+
+#if SPECTRA_RT_GUARD
+ #define SPECTRA_RT_SCOPE   const RealtimeGuard::ScopedAudioCallback rtGuardScope
+#else
+ #define SPECTRA_RT_SCOPE
+#endif
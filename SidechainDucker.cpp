@@ -0,0 +1,45 @@
+//============================== SidechainDucker.cpp ===============================
+#include "SidechainDucker.h"
+#include <cmath>
+
+//==============================================================================
+void SidechainDucker::prepare (double sampleRate, int maxBlockSize)
+{
+    sr = sampleRate > 0.0 ? sampleRate : 48000.0;
+    maxBlock = juce::jmax (32, maxBlockSize);
+    gains.assign ((size_t) maxBlock, 1.0f);
+
+    cached.attackMs = -1.0f;   // force le recalcul au premier bloc
+    reset();
+}
+
+void SidechainDucker::reset() noexcept
+{
+    env.fill (0.0f);
+    hold.fill (0.0f);
+    lastGain = 1.0f;
+    idle = true;
+}
+
+void SidechainDucker::updateCoefficients (const Settings& s) noexcept
+{
+    if (s.thresholdDb == cached.thresholdDb && s.depthDb == cached.depthDb
+         && s.attackMs == cached.attackMs && s.releaseMs == cached.releaseMs && s.holdMs == cached.holdMs)
+        return;
+
+    cached = s;
+
+    auto coeff = [this] (float ms)
+    {
+        const double samples = juce::jmax (1.0, (double) ms * 0.001 * sr);
+        return (float) std::exp (-1.0 / samples);
+    };
+
+    aAttack     = coeff (s.attackMs);
+    aRelease    = coeff (s.releaseMs);
+    holdSamples = (float) std::round (juce::jmax (0.0f, s.holdMs) * 0.001 * sr);
+
+    thrLin   = juce::Decibels::decibelsToGain (s.thresholdDb);
+    invThr   = 1.0f / juce::jmax (1.0e-6f, thrLin);
+    depthLin = juce::Decibels::decibelsToGain (juce::jmin (0.0f, s.depthDb));
+}
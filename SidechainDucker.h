@@ -0,0 +1,144 @@
+//============================== SidechainDucker.h ===============================
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+/**
+ * Ducking piloté par le bus sidechain.
+ *
+ * Suiveur d'enveloppe crête (attaque / maintien / relâchement) calculé sur
+ * kLanes voies en parallèle, une par canal sidechain: la boucle interne à
+ * largeur fixe se vectorise. Les enveloppes sont liées (max), puis converties
+ * en gain sans log: réduction nulle sous le seuil, complète à +6 dB au-dessus.
+ */
+class SidechainDucker
+{
+public:
+    static constexpr int kLanes = 4;
+
+    struct Settings
+    {
+        float thresholdDb = -30.0f;
+        float depthDb     = -12.0f;
+        float attackMs    = 10.0f;
+        float releaseMs   = 250.0f;
+        float holdMs      = 50.0f;
+    };
+
+    void prepare (double sampleRate, int maxBlockSize);
+    void reset() noexcept;
+
+    // Au repos: enveloppes éteintes et gain unitaire (aucun traitement nécessaire)
+    bool isIdle() const noexcept        { return idle; }
+
+    // Thread audio: calcule les gains puis les applique au bus principal
+    template <typename Sample>
+    void process (juce::AudioBuffer<Sample>& main, const juce::AudioBuffer<Sample>& key,
+                  const Settings&) noexcept;
+
+    float getGainReduction() const noexcept     { return lastGain; }
+
+private:
+    template <typename Sample>
+    void computeGains (const Sample* const* key, int numKeyChannels, int offset, int numSamples) noexcept;
+
+    void updateCoefficients (const Settings&) noexcept;
+
+    double sr = 48000.0;
+    int    maxBlock = 512;
+    std::vector<float> gains;
+
+    // État par voie
+    alignas (16) std::array<float, kLanes> env {};
+    alignas (16) std::array<float, kLanes> hold {};
+
+    // Coefficients (recalculés seulement si les réglages changent)
+    Settings cached { 1.0f, 1.0f, -1.0f, -1.0f, -1.0f };
+    float aAttack = 0.0f, aRelease = 0.0f, holdSamples = 0.0f;
+    float thrLin = 0.0316f, invThr = 31.6f, depthLin = 0.25f;
+
+    float lastGain = 1.0f;
+    bool  idle = true;
+};
+
+//==============================================================================
+template <typename Sample>
+void SidechainDucker::computeGains (const Sample* const* key, int numKeyChannels,
+                                    int offset, int numSamples) noexcept
+{
+    numKeyChannels = juce::jmin (numKeyChannels, kLanes);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        alignas (16) float x[kLanes] = {};
+        for (int k = 0; k < numKeyChannels; ++k)
+            x[k] = std::abs ((float) key[k][offset + i]);
+
+        // Attaque si au-dessus de l'enveloppe, sinon maintien puis relâchement
+        float linked = 0.0f;
+        for (int k = 0; k < kLanes; ++k)
+        {
+            const bool  rising = x[k] > env[(size_t) k];
+            const float h      = rising ? holdSamples : juce::jmax (0.0f, hold[(size_t) k] - 1.0f);
+            const float a      = rising ? aAttack : (h > 0.0f ? 1.0f : aRelease);
+
+            env [(size_t) k] = x[k] + a * (env[(size_t) k] - x[k]);
+            hold[(size_t) k] = h;
+            linked = juce::jmax (linked, env[(size_t) k]);
+        }
+
+        const float amount = juce::jlimit (0.0f, 1.0f, linked * invThr - 1.0f);
+        gains[(size_t) i] = 1.0f + amount * (depthLin - 1.0f);
+    }
+}
+
+template <typename Sample>
+void SidechainDucker::process (juce::AudioBuffer<Sample>& main, const juce::AudioBuffer<Sample>& key,
+                               const Settings& settings) noexcept
+{
+    const int numSamples = main.getNumSamples();
+    const int numKey     = key.getNumChannels();
+
+    if (numKey == 0 || numSamples == 0)
+        return;
+
+    // Seuil de ce bloc avant le test de repos (coût nul si inchangé)
+    updateCoefficients (settings);
+
+    // Sidechain muet et enveloppes retombées: rien à faire
+    if (idle && key.getMagnitude (0, numSamples) < thrLin * 1.0e-3f)
+        return;
+
+    for (int done = 0; done < numSamples; done += maxBlock)
+    {
+        const int n = juce::jmin (maxBlock, numSamples - done);
+        computeGains (key.getArrayOfReadPointers(), numKey, done, n);
+
+        for (int ch = 0; ch < main.getNumChannels(); ++ch)
+        {
+            auto* d = main.getWritePointer (ch, done);
+
+            if constexpr (std::is_same_v<Sample, float>)
+                juce::FloatVectorOperations::multiply (d, gains.data(), n);
+            else
+                for (int i = 0; i < n; ++i)
+                    d[i] *= (Sample) gains[(size_t) i];
+        }
+
+        lastGain = gains[(size_t) (n - 1)];
+    }
+
+    // Retour au repos dès que toutes les voies sont retombées très bas
+    float maxEnv = 0.0f;
+    for (auto e : env)
+        maxEnv = juce::jmax (maxEnv, e);
+
+    idle = maxEnv < thrLin * 1.0e-3f;
+    if (idle)
+    {
+        env.fill (0.0f);
+        hold.fill (0.0f);
+        lastGain = 1.0f;
+    }
+}
@@ -0,0 +1,609 @@
+//============================== SpectraBench.cpp ===============================
+// Outil console: débit du processeur Spectra hors hôte.
+// Usage: SpectraBench [ducking] [dither] [convolution] [snapshots] [--block <n>] [--seconds <s>]
+//        SpectraBench replay <fichier.sptrace> [--paced]
+// Sans mode explicite, tous les bancs sont exécutés (le rejeu exige une trace).
+// Code de sortie non nul si une vérification échoue, ou si une violation
+// temps-réel a été relevée (compilé avec SPECTRA_RT_GUARD=1).
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "RealtimeGuard.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+
+    struct BenchConfig
+    {
+        int    blockSize = 256;
+        double seconds   = 20.0;     // durée audio simulée par variante
+    };
+
+    //==============================================================================
+    // Bruit déterministe (graine fixe) pour des mesures comparables
+    void fillNoise (juce::AudioBuffer<float>& b, int firstChannel, int numChannels, float level, juce::int64 seed)
+    {
+        juce::Random r (seed);
+        for (int ch = firstChannel; ch < firstChannel + numChannels; ++ch)
+            for (int i = 0; i < b.getNumSamples(); ++i)
+                b.setSample (ch, i, level * (2.0f * r.nextFloat() - 1.0f));
+    }
+
+    // ns par échantillon (par canal de sortie) sur cfg.seconds d'audio
+    double timeProcessor (PluginAudioProcessor& p, const juce::AudioBuffer<float>& source, const BenchConfig& cfg)
+    {
+        juce::AudioBuffer<float> buffer (source.getNumChannels(), source.getNumSamples());
+        juce::MidiBuffer midi;
+
+        const int numBlocks = juce::jmax (1, (int) (cfg.seconds * kSampleRate / cfg.blockSize));
+        juce::int64 ticks = 0;
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            // Recopie hors mesure: le gain ne fait pas tendre le signal vers zéro
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                buffer.copyFrom (ch, 0, source, ch, 0, source.getNumSamples());
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            p.processBlock (buffer, midi);
+            ticks += juce::Time::getHighResolutionTicks() - start;
+        }
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds (ticks);
+        return seconds * 1.0e9 / ((double) numBlocks * cfg.blockSize);
+    }
+
+    void printResult (const char* name, double nsPerSample, double baseline)
+    {
+        const double realtime = 1.0e9 / (nsPerSample * kSampleRate);
+        std::printf ("  %-34s %9.2f ns/ech  %9.0fx temps reel", name, nsPerSample, realtime);
+        if (baseline > 0.0)
+            std::printf ("  (%+.1f%% vs gain seul)", 100.0 * (nsPerSample / baseline - 1.0));
+        std::printf ("\n");
+    }
+
+    //==============================================================================
+    // Ducking sidechain comparé au chemin gain seul
+    void benchDucking (const BenchConfig& cfg)
+    {
+        std::printf ("ducking (bloc %d, %.0f s @ %.0f Hz)\n", cfg.blockSize, cfg.seconds, kSampleRate);
+
+        auto run = [&cfg] (bool sidechain, float keyLevel)
+        {
+            PluginAudioProcessor p;
+            if (auto* bus = p.getBus (true, 1))
+                bus->enable (sidechain);
+
+            p.setRateAndBufferSizeDetails (kSampleRate, cfg.blockSize);
+            p.prepareToPlay (kSampleRate, cfg.blockSize);
+
+            juce::AudioBuffer<float> source (p.getTotalNumInputChannels(), cfg.blockSize);
+            source.clear();
+            fillNoise (source, 0, 2, 0.5f, 1234);
+            if (sidechain)
+                fillNoise (source, 2, source.getNumChannels() - 2, keyLevel, 5678);
+
+            const double ns = timeProcessor (p, source, cfg);
+            p.releaseResources();
+            return ns;
+        };
+
+        const double plain = run (false, 0.0f);
+        printResult ("gain seul (sidechain absent)", plain, 0.0);
+        printResult ("sidechain connecte, muet", run (true, 0.0f), plain);
+        printResult ("sidechain connecte, actif", run (true, 0.5f), plain);
+        std::printf ("\n");
+    }
+
+    //==============================================================================
+    // Référence scalaire: RNG séquentiel par échantillon, comme la plupart des dithers
+    void scalarTpdf (juce::AudioBuffer<float>& b, int bits, juce::Random& r)
+    {
+        const float scale = (float) (1 << (bits - 1));
+        const float lsb   = 1.0f / scale;
+
+        for (int ch = 0; ch < b.getNumChannels(); ++ch)
+        {
+            auto* x = b.getWritePointer (ch);
+            for (int i = 0; i < b.getNumSamples(); ++i)
+            {
+                const float d = r.nextFloat() - r.nextFloat();
+                x[i] = juce::jlimit (-1.0f, 1.0f - lsb, std::floor (x[i] * scale + d + 0.5f) * lsb);
+            }
+        }
+    }
+
+    // Dither vectorisé (TPDF et mise en forme F) comparé à la référence scalaire
+    void benchDither (const BenchConfig& cfg)
+    {
+        std::printf ("dither 16 bits (bloc %d, %.0f s @ %.0f Hz, stereo)\n", cfg.blockSize, cfg.seconds, kSampleRate);
+
+        juce::AudioBuffer<float> source (2, cfg.blockSize), buffer (2, cfg.blockSize);
+        fillNoise (source, 0, 2, 0.5f, 1234);
+        const int numBlocks = juce::jmax (1, (int) (cfg.seconds * kSampleRate / cfg.blockSize));
+
+        auto measure = [&] (auto&& processOne)
+        {
+            juce::int64 ticks = 0;
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                    buffer.copyFrom (ch, 0, source, ch, 0, cfg.blockSize);
+
+                const auto start = juce::Time::getHighResolutionTicks();
+                processOne();
+                ticks += juce::Time::getHighResolutionTicks() - start;
+            }
+
+            return juce::Time::highResolutionTicksToSeconds (ticks) * 1.0e9 / ((double) numBlocks * cfg.blockSize);
+        };
+
+        juce::Random rng (42);
+        const double scalar = measure ([&] { scalarTpdf (buffer, 16, rng); });
+        printResult ("TPDF scalaire (juce::Random)", scalar, 0.0);
+
+        OutputDither dither;
+        dither.prepare (cfg.blockSize);
+        const double vecTpdf = measure ([&] { dither.process (buffer, 16, OutputDither::Shape::tpdf); });
+        std::printf ("  %-34s %9.2f ns/ech  (x%.2f vs scalaire)\n", "TPDF compteur vectorise", vecTpdf, scalar / vecTpdf);
+
+        dither.reset();
+        const double vecShaped = measure ([&] { dither.process (buffer, 16, OutputDither::Shape::fWeighted); });
+        std::printf ("  %-34s %9.2f ns/ech  (x%.2f vs scalaire)\n\n", "TPDF + mise en forme F (9)", vecShaped, scalar / vecShaped);
+    }
+
+    //==============================================================================
+    // Convolution: coût moyen et pire bloc, RI de 2 s (la durée maximale) contre gain seul
+    void benchConvolution (const BenchConfig& cfg)
+    {
+        std::printf ("convolution RI %.1f s (bloc %d, %.0f s @ %.0f Hz, stereo)\n",
+                     PartitionedConvolver::kMaxSeconds, cfg.blockSize, cfg.seconds, kSampleRate);
+
+        // Queue de réverbération synthétique: bruit à décroissance exponentielle (-60 dB en 1,5 s)
+        const int irLength = (int) (PartitionedConvolver::kMaxSeconds * kSampleRate);
+        juce::AudioBuffer<float> ir (2, irLength);
+        fillNoise (ir, 0, 2, 1.0f, 4321);
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            auto* x = ir.getWritePointer (ch);
+            for (int i = 0; i < irLength; ++i)
+                x[i] *= 0.05f * std::pow (10.0f, -3.0f * (float) i / (1.5f * (float) kSampleRate));
+        }
+
+        auto run = [&] (bool withIr, double& worstMs)
+        {
+            PluginAudioProcessor p;
+            if (auto* bus = p.getBus (true, 1))
+                bus->enable (false);
+
+            p.setRateAndBufferSizeDetails (kSampleRate, cfg.blockSize);
+            p.prepareToPlay (kSampleRate, cfg.blockSize);
+            if (withIr)
+            {
+                // Noyau préparé par le thread de convolution: mesure une fois la RI prête
+                p.setImpulseResponse (ir, kSampleRate);
+                for (int i = 0; i < 10000 && p.getTailLengthSeconds() <= 0.0; ++i)
+                    juce::Thread::sleep (1);
+            }
+
+            juce::AudioBuffer<float> source (p.getTotalNumInputChannels(), cfg.blockSize), buffer;
+            fillNoise (source, 0, source.getNumChannels(), 0.5f, 1234);
+            juce::MidiBuffer midi;
+
+            const int numBlocks = juce::jmax (1, (int) (cfg.seconds * kSampleRate / cfg.blockSize));
+            juce::int64 ticks = 0, worst = 0;
+
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                buffer.makeCopyOf (source, true);
+
+                const auto start = juce::Time::getHighResolutionTicks();
+                p.processBlock (buffer, midi);
+                const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+                ticks += elapsed;
+                worst = juce::jmax (worst, elapsed);
+            }
+
+            p.releaseResources();
+            worstMs = juce::Time::highResolutionTicksToSeconds (worst) * 1000.0;
+            return juce::Time::highResolutionTicksToSeconds (ticks) * 1.0e9 / ((double) numBlocks * cfg.blockSize);
+        };
+
+        // Échéance d'un bloc: le pire cas doit rester loin en dessous
+        const double deadlineMs = 1000.0 * cfg.blockSize / kSampleRate;
+        double worstPlain = 0.0, worstIr = 0.0;
+
+        const double plain = run (false, worstPlain);
+        printResult ("gain seul", plain, 0.0);
+
+        const double convolved = run (true, worstIr);
+        printResult ("gain + RI 2 s", convolved, plain);
+
+        std::printf ("  %-34s %9.3f ms / %.3f ms (gain seul %.3f ms)\n\n",
+                     "pire bloc / echeance", worstIr, deadlineMs, worstPlain);
+    }
+
+    //==============================================================================
+    // Vérification des snapshots: mémorisation, rappel instantané, morphing jusqu'à la cible,
+    // programme courant renvoyé par l'hôte après un état sans effet, puis rappelable
+    bool checkSnapshots (const BenchConfig& cfg)
+    {
+        std::printf ("snapshots (bloc %d @ %.0f Hz)\n", cfg.blockSize, kSampleRate);
+
+        PluginAudioProcessor p;
+        if (auto* bus = p.getBus (true, 1))
+            bus->enable (false);
+
+        p.setRateAndBufferSizeDetails (kSampleRate, cfg.blockSize);
+        p.prepareToPlay (kSampleRate, cfg.blockSize);
+
+        auto* gain = p.parameters.getParameter ("gain");
+        juce::AudioBuffer<float> buffer (juce::jmax (p.getTotalNumInputChannels(), p.getTotalNumOutputChannels()), cfg.blockSize);
+        juce::MidiBuffer midi;
+
+        // Continu à 1: la sortie vaut le gain effectif (RI, ducking et dither inactifs)
+        auto runBlock = [&]
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::fill (buffer.getWritePointer (ch), 1.0f, cfg.blockSize);
+
+            p.processBlock (buffer, midi);
+            return buffer.getSample (0, cfg.blockSize - 1);
+        };
+
+        bool ok = true;
+        auto check = [&ok] (const char* name, bool passed, float value)
+        {
+            std::printf ("  %-34s %s (%.4f)\n", name, passed ? "ok" : "ECHEC", value);
+            ok = ok && passed;
+        };
+
+        gain->setValueNotifyingHost (0.2f);
+        p.storeSnapshot (0);
+        gain->setValueNotifyingHost (0.8f);
+        p.storeSnapshot (1);
+        runBlock();
+
+        p.setSnapshotMorphTime (0.0);
+        p.recallSnapshot (0);
+        const float instant = runBlock();
+        check ("rappel instantane", std::abs (instant - 0.2f) < 1.0e-4f, instant);
+
+        p.setSnapshotMorphTime (0.1);
+        p.recallSnapshot (1);
+        const float mid = runBlock();
+        check ("morphing en cours", mid > 0.2f + 1.0e-4f && mid < 0.8f - 1.0e-4f, mid);
+
+        for (int b = 0; b < (int) (0.2 * kSampleRate / cfg.blockSize) + 1; ++b)
+            runBlock();
+
+        const float reached = runBlock();
+        check ("morphing termine sur la cible", std::abs (reached - 0.8f) < 1.0e-4f
+                                                 && std::abs (gain->getValue() - 0.8f) < 1.0e-4f, reached);
+
+        // Retouche puis état rechargé: le programme courant renvoyé par l'hôte est ignoré
+        gain->setValueNotifyingHost (0.5f);
+        juce::MemoryBlock state;
+        p.getStateInformation (state);
+        p.setStateInformation (state.getData(), (int) state.getSize());
+        p.setCurrentProgram (1);
+        const float kept = runBlock();
+        check ("programme courant apres etat", std::abs (kept - 0.5f) < 1.0e-4f, kept);
+
+        // Rappel explicite du programme courant: les retouches sont annulées
+        p.setSnapshotMorphTime (0.0);
+        p.setCurrentProgram (1);
+        const float recalled = runBlock();
+        check ("programme courant rappele", std::abs (recalled - 0.8f) < 1.0e-4f, recalled);
+
+        p.releaseResources();
+        std::printf ("\n");
+        return ok;
+    }
+
+    //==============================================================================
+    // Rejeu: entrée enregistrée si capturée, sinon bruit sur le bus principal (sidechain muet)
+    template <typename Sample>
+    double replayBlock (PluginAudioProcessor& p, juce::AudioBuffer<Sample>& buffer,
+                        const TraceReader::Event& e, juce::Random& noise)
+    {
+        const int numChannels = juce::jmax (p.getTotalNumInputChannels(), p.getTotalNumOutputChannels());
+        buffer.setSize (numChannels, e.numSamples, false, false, true);
+        buffer.clear();
+
+        const bool recorded = e.input.getNumChannels() > 0;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* x = buffer.getWritePointer (ch);
+
+            if (recorded && ch < e.input.getNumChannels())
+            {
+                const auto* src = e.input.getReadPointer (ch);
+                for (int i = 0; i < e.numSamples; ++i)
+                    x[i] = (Sample) src[i];
+            }
+            else if (! recorded && ch < p.getMainBusNumInputChannels())
+            {
+                for (int i = 0; i < e.numSamples; ++i)
+                    x[i] = (Sample) (0.5f * (2.0f * noise.nextFloat() - 1.0f));
+            }
+        }
+
+        juce::MidiBuffer midi;
+        const auto start = juce::Time::getHighResolutionTicks();
+        p.processBlock (buffer, midi);
+        return juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start) * 1.0e6;
+    }
+
+    double percentile (std::vector<double> v, double q)
+    {
+        if (v.empty())
+            return 0.0;
+
+        const auto k = (size_t) juce::jlimit (0.0, (double) v.size() - 1.0, q * (double) (v.size() - 1));
+        std::nth_element (v.begin(), v.begin() + (std::ptrdiff_t) k, v.end());
+        return v[k];
+    }
+
+    // Trace de production rejouée à l'identique: tailles de bloc, fréquences,
+    // automation, états et programmes dans l'ordre de l'hôte. Échec si le rejeu
+    // ne peut pas être fidèle (trace illisible, bus ou RI non restaurables)
+    bool benchReplay (const juce::File& file, bool paced)
+    {
+        TraceReader reader;
+        if (! reader.open (file))
+        {
+            std::printf ("trace illisible: %s\n", file.getFullPathName().toRawUTF8());
+            return false;
+        }
+
+        std::printf ("rejeu %s%s\n  hote: %s, audio %s\n", file.getFileName().toRawUTF8(), paced ? " (cadence d'origine)" : "",
+                     reader.getHostDescription().toRawUTF8(), reader.hasAudio() ? "enregistre" : "bruit");
+
+        PluginAudioProcessor p;
+
+        // Correspondance par identifiant: une trace d'une autre version reste rejouable
+        std::vector<juce::RangedAudioParameter*> params;
+        for (const auto& id : reader.getParameterIds())
+            params.push_back (p.parameters.getParameter (id));
+
+        struct BlockTiming
+        {
+            juce::uint64 index;
+            int numSamples;
+            double recordedUs, replayedUs, budgetUs;
+        };
+
+        std::vector<BlockTiming> blocks;
+        int numPrepares = 0, numStates = 0, numPrograms = 0, numSkipped = 0;
+        juce::uint64 numDropped = 0;
+        double sampleRate = 0.0;
+
+        juce::AudioBuffer<float>  floatBuffer;
+        juce::AudioBuffer<double> doubleBuffer;
+        juce::Random noise (1234);
+        TraceReader::Event e;
+
+        const auto replayStart = juce::Time::getHighResolutionTicks();
+        bool faithful = true;
+
+        while (faithful && reader.next (e))
+        {
+            // Cadence d'origine: l'ordonnancement des threads de fond suit celui de l'hôte
+            if (paced)
+            {
+                const double target = (double) e.timeNs * 1.0e-9;
+                for (;;)
+                {
+                    const double ahead = target - juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - replayStart);
+                    if (ahead <= 0.0)
+                        break;
+
+                    if (ahead > 0.002)
+                        juce::Thread::sleep (1);
+                    else
+                        juce::Thread::yield();
+                }
+            }
+
+            switch (e.type)
+            {
+                case Trace::prepareRecord:
+                {
+                    // Disposition des bus de l'hôte avant prepareToPlay
+                    if (sampleRate > 0.0)
+                        p.releaseResources();
+
+                    auto layout = p.getBusesLayout();
+                    const auto mainSet = juce::AudioChannelSet::canonicalChannelSet (e.mainChannels);
+                    layout.inputBuses .getReference (0) = mainSet;
+                    layout.outputBuses.getReference (0) = mainSet;
+
+                    if (layout.inputBuses.size() > 1)
+                        layout.inputBuses.getReference (1) = e.sidechainChannels > 0
+                                                           ? juce::AudioChannelSet::canonicalChannelSet (e.sidechainChannels)
+                                                           : juce::AudioChannelSet::disabled();
+
+                    if (! p.setBusesLayout (layout))
+                    {
+                        std::printf ("  disposition non restauree: %d canaux, sidechain %d\n",
+                                     e.mainChannels, e.sidechainChannels);
+                        faithful = false;
+                        break;
+                    }
+
+                    p.setRateAndBufferSizeDetails (e.sampleRate, e.blockSize);
+                    p.prepareToPlay (e.sampleRate, e.blockSize);
+                    sampleRate = e.sampleRate;
+                    ++numPrepares;
+                    break;
+                }
+
+                case Trace::stateRecord:
+                    p.setStateInformation (e.state.getData(), (int) e.state.getSize());
+
+                    // RI référencée par chemin absolu: absente ici, le rejeu serait sans convolution
+                    if (auto xml = juce::AudioProcessor::getXmlFromBinary (e.state.getData(), (int) e.state.getSize()))
+                    {
+                        const auto irPath = xml->getStringAttribute ("irFile");
+                        if (irPath.isNotEmpty() && p.getImpulseResponseFile().getFullPathName() != irPath)
+                        {
+                            std::printf ("  RI de l'etat introuvable ou illisible: %s\n", irPath.toRawUTF8());
+                            faithful = false;
+                            break;
+                        }
+                    }
+
+                    // Les histogrammes de la session enregistrée ne décrivent pas le rejeu
+                    p.getStatistics().reset();
+                    ++numStates;
+                    break;
+
+                case Trace::programRecord:
+                    p.setCurrentProgram (e.program);
+                    ++numPrograms;
+                    break;
+
+                case Trace::blockRecord:
+                {
+                    // Blocs antérieurs au premier prepareToPlay: non rejouables
+                    if (sampleRate <= 0.0)
+                    {
+                        ++numSkipped;
+                        break;
+                    }
+
+                    for (const auto& [index, value] : e.changes)
+                        if (juce::isPositiveAndBelow (index, (int) params.size()) && params[(size_t) index] != nullptr)
+                            params[(size_t) index]->setValueNotifyingHost (value);
+
+                    numDropped += e.droppedBefore;
+
+                    const double us = e.doublePrecision ? replayBlock (p, doubleBuffer, e, noise)
+                                                        : replayBlock (p, floatBuffer,  e, noise);
+
+                    blocks.push_back ({ e.blockIndex, e.numSamples, (double) e.durationNs * 1.0e-3,
+                                        us, 1.0e6 * e.numSamples / sampleRate });
+                    break;
+                }
+            }
+        }
+
+        if (! faithful)
+        {
+            p.releaseResources();
+            std::printf ("  rejeu interrompu: non fidele a l'enregistrement\n\n");
+            return false;
+        }
+
+        // Laisse le thread statistiques intégrer les dernières trames
+        juce::Thread::sleep (250);
+        p.releaseResources();
+
+        std::vector<double> recorded, replayed;
+        int overRecorded = 0, overReplayed = 0;
+        for (const auto& b : blocks)
+        {
+            recorded.push_back (b.recordedUs);
+            replayed.push_back (b.replayedUs);
+            overRecorded += b.recordedUs > b.budgetUs ? 1 : 0;
+            overReplayed += b.replayedUs > b.budgetUs ? 1 : 0;
+        }
+
+        std::printf ("  blocs %d (ignores %d, perdus a l'enregistrement %llu), prepare %d, etats %d, programmes %d\n",
+                     (int) blocks.size(), numSkipped, (unsigned long long) numDropped, numPrepares, numStates, numPrograms);
+        std::printf ("  %-22s %10s %10s %10s %10s\n", "duree bloc (us)", "p50", "p99", "max", "> budget");
+        std::printf ("  %-22s %10.1f %10.1f %10.1f %10d\n", "enregistree", percentile (recorded, 0.5), percentile (recorded, 0.99),
+                     percentile (recorded, 1.0), overRecorded);
+        std::printf ("  %-22s %10.1f %10.1f %10.1f %10d\n", "rejouee", percentile (replayed, 0.5), percentile (replayed, 0.99),
+                     percentile (replayed, 1.0), overReplayed);
+
+        // Blocs les plus lents chez le client, avec leur coût rejoué: préemption
+        // de l'hôte si le rejeu est rapide, coût du traitement sinon
+        std::sort (blocks.begin(), blocks.end(), [] (const auto& a, const auto& b) { return a.recordedUs > b.recordedUs; });
+
+        std::printf ("  blocs les plus lents a l'enregistrement:\n");
+        for (size_t i = 0; i < juce::jmin ((size_t) 5, blocks.size()); ++i)
+            std::printf ("    #%-10llu n=%-5d enregistre %9.1f us  rejoue %9.1f us  budget %9.1f us\n",
+                         (unsigned long long) blocks[i].index, blocks[i].numSamples,
+                         blocks[i].recordedUs, blocks[i].replayedUs, blocks[i].budgetUs);
+
+        using Stats = LevelStatistics;
+        const auto& st = p.getStatistics();
+        std::printf ("  sortie rejouee: ST LUFS p50 %.1f, peak p99 %.1f dBFS, %.1f s > -1 dBFS sur %.1f s\n",
+                     st.getQuantile (Stats::shortTermLoudness, 0.5), st.getQuantile (Stats::peak, 0.99),
+                     st.getSecondsAbove (Stats::peak, -1.0f), st.getSeconds (Stats::peak));
+
+        std::printf ("\n");
+        return true;
+    }
+}
+
+//==============================================================================
+// Hook CI: violations relevées dans processBlock pendant les bancs ou le rejeu
+static int finish (int result)
+{
+   #if SPECTRA_RT_GUARD
+    const int numViolations = RealtimeGuard::getNumViolations();
+    if (numViolations > 0)
+    {
+        std::printf ("%d violation(s) temps-reel dans le callback audio\n", numViolations);
+
+        for (int i = 0; i < juce::jmin (numViolations, RealtimeGuard::kMaxRecords); ++i)
+        {
+            RealtimeGuard::Record r;
+            if (RealtimeGuard::getViolation (i, r))
+                std::printf ("%s", RealtimeGuard::describe (r).toRawUTF8());
+        }
+
+        return 1;
+    }
+   #endif
+
+    return result;
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::StringArray args (argv + 1, argc - 1);
+    BenchConfig cfg;
+
+    if (const int i = args.indexOf ("--block"); i >= 0)
+        cfg.blockSize = juce::jlimit (16, 8192, args[i + 1].getIntValue());
+
+    if (const int i = args.indexOf ("--seconds"); i >= 0)
+        cfg.seconds = juce::jmax (1.0, args[i + 1].getDoubleValue());
+
+    if (const int i = args.indexOf ("replay"); i >= 0)
+    {
+        const bool replayed = benchReplay (juce::File::getCurrentWorkingDirectory().getChildFile (args[i + 1]),
+                                           args.contains ("--paced"));
+        return finish (replayed ? 0 : 1);
+    }
+
+    const bool all = ! (args.contains ("ducking") || args.contains ("dither") || args.contains ("convolution")
+                        || args.contains ("snapshots"));
+    int result = 0;
+
+    if (all || args.contains ("ducking"))
+        benchDucking (cfg);
+
+    if (all || args.contains ("dither"))
+        benchDither (cfg);
+
+    if (all || args.contains ("convolution"))
+        benchConvolution (cfg);
+
+    if (all || args.contains ("snapshots"))
+        result |= checkSnapshots (cfg) ? 0 : 1;
+
+    return finish (result);
+}
@@ -0,0 +1,70 @@
+//============================== StereoAnalysis.cpp ===============================
+#include "StereoAnalysis.h"
+
+//==============================================================================
+void StereoCorrelationMeter::prepare (double sampleRate, double timeConstantSeconds)
+{
+    sr  = sampleRate > 0.0 ? sampleRate : 48000.0;
+    tau = juce::jmax (0.001, timeConstantSeconds);
+    reset();
+}
+
+void StereoCorrelationMeter::reset() noexcept
+{
+    sLR = sLL = sRR = 0.0;
+    correlation.store (0.0f, std::memory_order_relaxed);
+}
+
+//==============================================================================
+GoniometerBuffer::GoniometerBuffer()
+    : points ((size_t) kCapacity)
+{
+}
+
+void GoniometerBuffer::prepare (double sampleRate, double frameRateHz)
+{
+    // Débit de points borné: kMaxPointsPerFrame par image UI au maximum
+    const double rate = sampleRate > 0.0 ? sampleRate : 48000.0;
+    const double pointsPerSecond = (double) kMaxPointsPerFrame * juce::jmax (1.0, frameRateHz);
+    decimation = juce::jmax (1, (int) std::ceil (rate / pointsPerSecond));
+    reset();
+}
+
+void GoniometerBuffer::reset() noexcept
+{
+    // Position de lecture laissée au lecteur (SPSC): il vide la FIFO à sa prochaine lecture
+    nextIndex = 0;
+    generation.fetch_add (1, std::memory_order_release);
+}
+
+void GoniometerBuffer::discardPending() noexcept
+{
+    readerGeneration = generation.load (std::memory_order_acquire);
+    fifo.finishedRead (fifo.getNumReady());
+}
+
+int GoniometerBuffer::readLatest (juce::Point<float>* dest, int maxPoints) noexcept
+{
+    // Points d'avant le dernier reset(): écartés, sans croiser l'écrivain
+    const auto gen = generation.load (std::memory_order_acquire);
+    if (gen != readerGeneration)
+    {
+        readerGeneration = gen;
+        fifo.finishedRead (fifo.getNumReady());
+    }
+
+    const int ready = fifo.getNumReady();
+
+    // Les points les plus anciens au-delà du budget sont simplement écartés
+    if (ready > maxPoints)
+        fifo.finishedRead (ready - maxPoints);
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (juce::jmin (ready, maxPoints), start1, size1, start2, size2);
+
+    std::copy_n (points.data() + start1, size1, dest);
+    std::copy_n (points.data() + start2, size2, dest + size1);
+    fifo.finishedRead (size1 + size2);
+
+    return size1 + size2;
+}
@@ -0,0 +1,155 @@
+//============================== StereoAnalysis.h ===============================
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+/**
+ * Corrélation stéréo glissante (-1..+1).
+ * Sommes L·R, L², R² accumulées sur kLanes voies indépendantes (vectorisables
+ * sans réassociation flottante), puis lissage exponentiel par bloc.
+ */
+class StereoCorrelationMeter
+{
+public:
+    void prepare (double sampleRate, double timeConstantSeconds = 0.3);
+    void reset() noexcept;
+
+    // Thread audio
+    template <typename Sample>
+    void process (const Sample* left, const Sample* right, int numSamples) noexcept;
+
+    // Thread UI
+    float getCorrelation() const noexcept { return correlation.load (std::memory_order_relaxed); }
+
+private:
+    static constexpr int kLanes = 8;
+
+    double sr  = 48000.0;
+    double tau = 0.3;
+    double sLR = 0.0, sLL = 0.0, sRR = 0.0;
+
+    std::atomic<float> correlation { 0.0f };
+};
+
+//==============================================================================
+/**
+ * Flux de points du goniomètre (M/S tourné de 45°), décimé côté audio.
+ * FIFO mono-producteur / mono-consommateur sans verrou: l'audio ne bloque
+ * jamais (points perdus si plein), l'UI ne lit que les kMaxPointsPerFrame
+ * plus récents, quel que soit sr ou la taille de bloc.
+ * reset() ne touche pas la FIFO: il incrémente une génération, et le lecteur
+ * (seul propriétaire de la position de lecture) vide les points périmés.
+ */
+class GoniometerBuffer
+{
+public:
+    static constexpr int kMaxPointsPerFrame = 1024;
+
+    GoniometerBuffer();
+
+    void prepare (double sampleRate, double frameRateHz = 30.0);
+    void reset() noexcept;
+
+    // Thread audio
+    template <typename Sample>
+    void push (const Sample* left, const Sample* right, int numSamples) noexcept;
+
+    // Thread UI: copie au plus maxPoints points récents, renvoie le nombre lu
+    int readLatest (juce::Point<float>* dest, int maxPoints) noexcept;
+
+    // Thread UI: écarte les points accumulés sans lecteur (éditeur fermé)
+    void discardPending() noexcept;
+
+private:
+    static constexpr int kCapacity = 8192;
+
+    juce::AbstractFifo fifo { kCapacity };
+    std::vector<juce::Point<float>> points;
+    int decimation = 1;
+    int nextIndex  = 0;    // position du prochain point dans le bloc suivant
+
+    // Écrivain → lecteur: points antérieurs à écarter
+    std::atomic<juce::uint32> generation { 0 };
+    juce::uint32 readerGeneration = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (GoniometerBuffer)
+};
+
+//==============================================================================
+template <typename Sample>
+void StereoCorrelationMeter::process (const Sample* left, const Sample* right, int numSamples) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    float lr[kLanes] = {}, ll[kLanes] = {}, rr[kLanes] = {};
+
+    int i = 0;
+    for (; i + kLanes <= numSamples; i += kLanes)
+    {
+        for (int k = 0; k < kLanes; ++k)
+        {
+            const float a = (float) left[i + k];
+            const float b = (float) right[i + k];
+            lr[k] += a * b;
+            ll[k] += a * a;
+            rr[k] += b * b;
+        }
+    }
+
+    float tLR = 0.0f, tLL = 0.0f, tRR = 0.0f;
+    for (int k = 0; k < kLanes; ++k) { tLR += lr[k]; tLL += ll[k]; tRR += rr[k]; }
+
+    for (; i < numSamples; ++i)
+    {
+        const float a = (float) left[i];
+        const float b = (float) right[i];
+        tLR += a * b;
+        tLL += a * a;
+        tRR += b * b;
+    }
+
+    // Moyennes du bloc intégrées avec une constante de temps fixe
+    const double n = (double) numSamples;
+    const double d = std::exp (-n / (tau * sr));
+    sLR = d * sLR + (1.0 - d) * (tLR / n);
+    sLL = d * sLL + (1.0 - d) * (tLL / n);
+    sRR = d * sRR + (1.0 - d) * (tRR / n);
+
+    const double energy = std::sqrt (sLL * sRR);
+    const float  c = energy > 1.0e-10 ? (float) (sLR / energy) : 0.0f;
+    correlation.store (juce::jlimit (-1.0f, 1.0f, c), std::memory_order_relaxed);
+}
+
+template <typename Sample>
+void GoniometerBuffer::push (const Sample* left, const Sample* right, int numSamples) noexcept
+{
+    // Indices des échantillons retenus dans ce bloc
+    const int first  = nextIndex;
+    const int wanted = first < numSamples ? 1 + (numSamples - 1 - first) / decimation : 0;
+    nextIndex = first + wanted * decimation - numSamples;
+
+    if (wanted == 0)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (wanted, start1, size1, start2, size2);
+
+    constexpr float k = 0.70710678f;
+    int src = first;
+    auto fill = [&] (int start, int size) noexcept
+    {
+        for (int j = 0; j < size; ++j, src += decimation)
+        {
+            const float l = (float) left[src];
+            const float r = (float) right[src];
+            points[(size_t) (start + j)] = { (r - l) * k, (l + r) * k };
+        }
+    };
+
+    fill (start1, size1);
+    fill (start2, size2);
+    fifo.finishedWrite (size1 + size2);
+}
@@ -0,0 +1,181 @@
+//============================== TelemetryExport.cpp ===============================
+#include "TelemetryExport.h"
+
+//==============================================================================
+juce::File Telemetry::getRegionFile()
+{
+    // Version dans le nom: une région d'une version antérieure restée dans le
+    // dossier temporaire ne bloque jamais les écrivains actuels
+    return juce::File::getSpecialLocation (juce::File::tempDirectory)
+             .getChildFile ("SpectraTelemetry-v" + juce::String (Telemetry::kVersion) + ".shm");
+}
+
+bool Telemetry::readSlot (const Slot& s, Payload& dest, int64_t& heartbeatMs) noexcept
+{
+    for (int attempt = 0; attempt < 8; ++attempt)
+    {
+        const uint32_t before = s.sequence.load (std::memory_order_acquire);
+        if ((before & 1u) != 0)
+            continue;
+
+        std::memcpy (&dest, &s.data, sizeof (Payload));
+        heartbeatMs = s.heartbeatMs.load (std::memory_order_relaxed);
+
+        std::atomic_thread_fence (std::memory_order_acquire);
+        if (s.sequence.load (std::memory_order_relaxed) == before)
+            return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+TelemetryExporter::TelemetryExporter()
+{
+    const auto file = Telemetry::getRegionFile();
+    const auto size = (juce::int64) sizeof (Telemetry::Region);
+
+    // Extension du fichier uniquement (jamais tronqué: d'autres processus le mappent)
+    if (file.getSize() < size)
+    {
+        juce::FileOutputStream out (file);
+        if (out.openedOk())
+        {
+            juce::HeapBlock<char> zeros ((size_t) size, true);
+            out.write (zeros.getData(), (size_t) (size - out.getPosition()));
+            out.flush();
+        }
+    }
+
+    mapping = std::make_unique<juce::MemoryMappedFile> (file, juce::MemoryMappedFile::readWrite, false);
+
+    if (mapping->getData() == nullptr || (juce::int64) mapping->getSize() < size)
+    {
+        mapping.reset();
+        return;
+    }
+
+    auto* region = static_cast<Telemetry::Region*> (mapping->getData());
+
+    // Premier arrivé: pose sa marque, écrit l'en-tête puis publie le magic. Une marque
+    // restée en place après l'attente (initialiseur disparu) est retirée, puis nouvel essai.
+    uint32_t claim = 0;
+    while (claim == 0 || claim == Telemetry::kMagic)
+        claim = (uint32_t) juce::Random::getSystemRandom().nextInt();
+
+    for (int attempt = 0; attempt < 3; ++attempt)
+    {
+        uint32_t expected = 0;
+        if (region->magic.compare_exchange_strong (expected, claim))
+        {
+            region->version  = Telemetry::kVersion;
+            region->numSlots = (uint32_t) Telemetry::kNumSlots;
+            region->slotSize = (uint32_t) sizeof (Telemetry::Slot);
+            region->magic.store (Telemetry::kMagic);
+            break;
+        }
+
+        if (expected == Telemetry::kMagic)
+            break;
+
+        for (int i = 0; i < 100 && region->magic.load() == expected; ++i)
+            juce::Thread::sleep (1);
+
+        // Seule la marque observée est retirée: un nouvel initialiseur n'est pas interrompu
+        region->magic.compare_exchange_strong (expected, 0u);
+    }
+
+    if (region->magic.load() != Telemetry::kMagic
+         || region->version  != Telemetry::kVersion
+         || region->slotSize != (uint32_t) sizeof (Telemetry::Slot))
+    {
+        mapping.reset();
+        return;
+    }
+
+    token = (uint32_t) juce::Random::getSystemRandom().nextInt() | 1u;
+
+    // Nom préparé ici: claimSlot() est rappelé depuis le thread audio
+    ("Spectra " + juce::String::toHexString ((int) token)).copyToUTF8 (name, (size_t) Telemetry::kNameSize);
+
+    // Région valide: mapping conservé même sans slot libre, publish() réessaiera
+    claimSlot();
+}
+
+TelemetryExporter::~TelemetryExporter()
+{
+    if (slot != nullptr)
+    {
+        auto expected = token;
+        slot->owner.compare_exchange_strong (expected, 0u);
+    }
+}
+
+bool TelemetryExporter::claimSlot() noexcept
+{
+    auto* region = static_cast<Telemetry::Region*> (mapping->getData());
+    const auto now = (int64_t) juce::Time::currentTimeMillis();
+
+    // Slot libre d'abord, sinon slot abandonné (processus disparu sans libérer)
+    for (int pass = 0; pass < 2 && slot == nullptr; ++pass)
+    {
+        for (auto& s : region->slots)
+        {
+            uint32_t expected = s.owner.load();
+            const bool candidate = pass == 0 ? expected == 0
+                                             : now - s.heartbeatMs.load() > kStaleAfterMs;
+
+            if (candidate && s.owner.compare_exchange_strong (expected, token))
+            {
+                slot = &s;
+                break;
+            }
+        }
+    }
+
+    if (slot == nullptr)
+        return false;
+
+    // Séquence forcée impaire puis paire: le précédent écrivain a pu mourir en pleine écriture
+    const uint32_t seq = slot->sequence.load() | 1u;
+    slot->sequence.store (seq);
+    std::atomic_thread_fence (std::memory_order_release);
+
+    std::memcpy (slot->name, name, sizeof (name));
+    slot->data = {};
+    slot->heartbeatMs.store (now);
+
+    slot->sequence.store (seq + 1, std::memory_order_release);
+    return true;
+}
+
+//==============================================================================
+void TelemetryExporter::publish (const Telemetry::Payload& payload, double sampleRate, int numSamples) noexcept
+{
+    if (mapping == nullptr)
+        return;
+
+    samplesSincePublish += numSamples;
+    if (samplesSincePublish < (int) (sampleRate / kPublishHz))
+        return;
+
+    samplesSincePublish = 0;
+
+    // Slot repris pendant une pause de l'hôte (battement de cœur ancien), ou
+    // aucun slot libre jusqu'ici: nouveau slot, sans allocation
+    if (slot == nullptr || slot->owner.load (std::memory_order_relaxed) != token)
+    {
+        slot = nullptr;
+        if (! claimSlot())
+            return;
+    }
+
+    const uint32_t seq = slot->sequence.load (std::memory_order_relaxed);
+    slot->sequence.store (seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+
+    std::memcpy (&slot->data, &payload, sizeof (Telemetry::Payload));
+    slot->heartbeatMs.store ((int64_t) juce::Time::currentTimeMillis(), std::memory_order_relaxed);
+
+    slot->sequence.store (seq + 2, std::memory_order_release);
+}
@@ -0,0 +1,93 @@
+//============================== TelemetryExport.h ===============================
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Télémétrie partagée entre toutes les instances de la machine.
+ *
+ * Un fichier mappé en mémoire (dossier temporaire) contient kNumSlots slots.
+ * Chaque instance réserve un slot par CAS sur 'owner' et y publie ses mesures
+ * sous seqlock: l'écriture (thread audio) est sans attente, la lecture
+ * (tableau de bord, TelemetryReader) réessaie sans jamais bloquer l'écrivain.
+ */
+namespace Telemetry
+{
+    constexpr uint32_t kMagic    = 0x53505431; // "SPT1"
+    constexpr uint32_t kVersion  = 2;
+    constexpr int      kNumSlots = 64;
+    constexpr int      kNameSize = 48;
+
+    // Données publiées, copiées telles quelles sous seqlock
+    struct Payload
+    {
+        float    inLevel       = 0.0f;
+        float    outLevel      = 0.0f;
+        float    correlation   = 0.0f;
+        float    momentaryLufs = -120.0f;
+        float    shortTermLufs = -120.0f;
+        float    cpuLoad       = 0.0f;     // proportion du budget temps-réel
+        double   sampleRate    = 0.0;
+        int32_t  blockSize     = 0;
+        int32_t  numChannels   = 0;
+        uint64_t blocksProcessed = 0;
+        float    editorFirstPaintMs   = -1.0f;   // dernière ouverture de l'éditeur
+        float    editorFullFidelityMs = -1.0f;   // -1 = pas encore mesuré
+    };
+
+    struct alignas (64) Slot
+    {
+        std::atomic<uint32_t> owner;        // 0 = libre, sinon jeton d'instance
+        std::atomic<uint32_t> sequence;     // impair = écriture en cours
+        std::atomic<int64_t>  heartbeatMs;  // horloge murale de la dernière publication
+        char    name[kNameSize];
+        Payload data;
+    };
+
+    struct Region
+    {
+        std::atomic<uint32_t> magic;
+        uint32_t version;
+        uint32_t numSlots;
+        uint32_t slotSize;
+        Slot     slots[kNumSlots];
+    };
+
+    static_assert (std::atomic<uint32_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free,
+                   "les atomiques partagés entre processus doivent être sans verrou");
+
+    // Emplacement du fichier partagé
+    juce::File getRegionFile();
+
+    // Lecture cohérente d'un slot (false si écriture en cours après quelques essais)
+    bool readSlot (const Slot&, Payload& dest, int64_t& heartbeatMs) noexcept;
+}
+
+//==============================================================================
+/** Écrivain: un slot par instance de processeur. */
+class TelemetryExporter
+{
+public:
+    TelemetryExporter();
+    ~TelemetryExporter();
+
+    bool isActive() const noexcept          { return slot != nullptr; }
+
+    // Thread audio: publication limitée à ~kPublishHz
+    void publish (const Telemetry::Payload&, double sampleRate, int numSamples) noexcept;
+
+    static constexpr double kPublishHz = 50.0;
+    static constexpr int64_t kStaleAfterMs = 10000;
+
+private:
+    bool claimSlot() noexcept;
+
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    Telemetry::Slot* slot = nullptr;
+    uint32_t token = 0;
+    char name[Telemetry::kNameSize] {};
+    int samplesSincePublish = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TelemetryExporter)
+};
@@ -0,0 +1,82 @@
+//============================== TelemetryReader.cpp ===============================
+// Outil console: suit tous les slots de télémétrie Spectra de la machine.
+// Usage: TelemetryReader [--once] [--interval <ms>]
+// Lecture seule du fichier mappé; ne bloque jamais les instances écrivaines.
+#include <JuceHeader.h>
+#include "TelemetryExport.h"
+#include <cstdio>
+
+//==============================================================================
+static void printSlots (const Telemetry::Region& region)
+{
+    const auto now = (int64_t) juce::Time::currentTimeMillis();
+    int active = 0;
+
+    std::printf ("%-24s %7s %7s %6s %8s %8s %6s %8s %6s %13s\n",
+                 "instance", "in", "out", "corr", "M LUFS", "S LUFS", "cpu%", "sr", "block", "ui ms 1st/full");
+
+    for (const auto& slot : region.slots)
+    {
+        if (slot.owner.load (std::memory_order_relaxed) == 0)
+            continue;
+
+        Telemetry::Payload p;
+        int64_t heartbeat = 0;
+        char name[Telemetry::kNameSize + 1] = {};
+        std::memcpy (name, slot.name, (size_t) Telemetry::kNameSize);
+
+        if (! Telemetry::readSlot (slot, p, heartbeat))
+        {
+            std::printf ("%-24s (écriture en cours)\n", name);
+            continue;
+        }
+
+        const bool stale = now - heartbeat > 1000;
+        std::printf ("%-24s %7.3f %7.3f %+6.2f %8.1f %8.1f %6.1f %8.0f %6d %6.0f/%-6.0f%s\n",
+                     name, p.inLevel, p.outLevel, p.correlation,
+                     p.momentaryLufs, p.shortTermLufs, p.cpuLoad * 100.0f,
+                     p.sampleRate, p.blockSize, p.editorFirstPaintMs, p.editorFullFidelityMs,
+                     stale ? "  [inactif]" : "");
+        ++active;
+    }
+
+    std::printf ("-- %d instance(s)\n\n", active);
+    std::fflush (stdout);
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::StringArray args (argv + 1, argc - 1);
+    const bool once = args.contains ("--once");
+    const int  idx  = args.indexOf ("--interval");
+    const int  intervalMs = idx >= 0 ? juce::jmax (50, args[idx + 1].getIntValue()) : 500;
+
+    const auto file = Telemetry::getRegionFile();
+
+    for (;;)
+    {
+        juce::MemoryMappedFile mapping (file, juce::MemoryMappedFile::readOnly, false);
+        const auto* region = static_cast<const Telemetry::Region*> (mapping.getData());
+
+        if (region == nullptr || mapping.getSize() < sizeof (Telemetry::Region)
+             || region->magic.load() != Telemetry::kMagic)
+        {
+            std::printf ("Aucune région de télémétrie dans %s\n", file.getFullPathName().toRawUTF8());
+        }
+        else if (region->version != Telemetry::kVersion || region->slotSize != (uint32_t) sizeof (Telemetry::Slot))
+        {
+            std::printf ("Version de télémétrie incompatible (%u)\n", region->version);
+            return 1;
+        }
+        else
+        {
+            printSlots (*region);
+        }
+
+        if (once)
+            return 0;
+
+        juce::Thread::sleep (intervalMs);
+    }
+}
@@ -0,0 +1,486 @@
+//============================== TraceRecorder.cpp ===============================
+#include "TraceRecorder.h"
+#include <cstring>
+#include <limits>
+#include <thread>
+
+//==============================================================================
+void TraceRecorder::FifoCursor::write (const void* src, int numBytes) noexcept
+{
+    const auto* bytes = static_cast<const char*> (src);
+
+    // Partie dans la première zone, reste dans la seconde (après bouclage)
+    if (pos < size1)
+    {
+        const int n = juce::jmin (numBytes, size1 - pos);
+        std::memcpy (ring + start1 + pos, bytes, (size_t) n);
+        bytes += n;
+        numBytes -= n;
+        pos += n;
+    }
+
+    if (numBytes > 0)
+    {
+        jassert (pos - size1 + numBytes <= size2);
+        std::memcpy (ring + start2 + (pos - size1), bytes, (size_t) numBytes);
+        pos += numBytes;
+    }
+}
+
+//==============================================================================
+TraceRecorder::TraceRecorder() = default;
+
+TraceRecorder::~TraceRecorder()
+{
+    stop();
+}
+
+bool TraceRecorder::start (const juce::File& f, juce::AudioProcessor& processor, bool withAudio,
+                           const juce::MemoryBlock& initialState)
+{
+    stop();
+
+    auto out = std::make_unique<juce::FileOutputStream> (f);
+    if (out->failedToOpen())
+        return false;
+
+    out->setPosition (0);
+    out->truncate();
+
+    // Tampon dimensionné sur la configuration courante (48 kHz et blocs de 64 avant prepareToPlay).
+    // Plafond commun à toutes les instances: au-delà, la trace n'enregistre que les blocs.
+    if (withAudio && ! reserveRing (ringBytesFor (processor, true), false))
+        withAudio = false;
+
+    if (! withAudio)
+        reserveRing (ringBytesFor (processor, false), true);
+
+    // En-tête: identifiants des paramètres dans l'ordre des enregistrements
+    params.clear();
+    for (auto* p : processor.getParameters())
+        if ((int) params.size() < Trace::kMaxParameters)
+            params.push_back (p);
+
+    out->writeInt ((int) Trace::kMagic);
+    out->writeInt ((int) Trace::kVersion);
+    out->writeByte (withAudio ? 1 : 0);
+    out->writeString (juce::AudioProcessor::getWrapperTypeDescription (processor.wrapperType)
+                      + " / " + juce::File::getSpecialLocation (juce::File::hostApplicationPath).getFileName()
+                      + " / " + juce::SystemStats::getOperatingSystemName());
+    out->writeInt ((int) params.size());
+
+    for (auto* p : params)
+    {
+        if (auto* hosted = dynamic_cast<juce::HostedAudioProcessorParameter*> (p))
+            out->writeString (hosted->getParameterID());
+        else
+            out->writeString (p->getName (64));
+    }
+
+    // Valeurs initiales NaN: le premier bloc enregistre tous les paramètres
+    lastValues.assign (params.size(), std::numeric_limits<float>::quiet_NaN());
+    changed.clear();
+    changed.reserve (params.size());
+
+    ring.assign ((size_t) ringBytes, 0);
+    fifo = std::make_unique<juce::AbstractFifo> ((int) ringBytes);
+
+    captureAudio     = withAudio;
+    startTicks       = juce::Time::getHighResolutionTicks();
+    nsPerTick        = 1.0e9 / (double) juce::Time::getHighResolutionTicksPerSecond();
+    droppedSinceLast = 0;
+    droppedTotal.store (0);
+
+    {
+        const juce::ScopedLock sl (controlLock);
+        controls.clear();
+    }
+
+    stream = std::move (out);
+    file = f;
+    lastFlushMs = juce::Time::getMillisecondCounter();
+
+    active.store (true);
+
+    // Point de départ du rejeu: l'état complet au moment du démarrage
+    stateRestored (initialState.getData(), (int) initialState.getSize());
+
+    thread->addTimeSliceClient (this);
+    return true;
+}
+
+void TraceRecorder::stop()
+{
+    if (! active.exchange (false))
+        return;
+
+    // Le bloc en cours (s'il a vu 'active') termine son enregistrement
+    while (inBlock.load())
+        std::this_thread::yield();
+
+    thread->removeTimeSliceClient (this);
+
+    drain();
+    stream->flush();
+    stream.reset();
+
+    // Tampon rendu au budget commun
+    fifo.reset();
+    std::vector<char>().swap (ring);
+    totalRingBytes.fetch_sub (ringBytes);
+    ringBytes = 0;
+}
+
+juce::int64 TraceRecorder::ringBytesFor (const juce::AudioProcessor& processor, bool withAudio)
+{
+    const double rate    = processor.getSampleRate() > 0.0 ? processor.getSampleRate() : 48000.0;
+    const int blockSize  = processor.getBlockSize() > 0 ? processor.getBlockSize() : 64;
+    const int channels   = withAudio ? processor.getTotalNumInputChannels() : 0;
+
+    // Par seconde: enregistrements de bloc (quelques paramètres modifiés) et audio float32
+    const double blockBytes  = 5 + Trace::kBlockFixedBytes + 8 * Trace::kChangeBytes;
+    const double perSecond   = rate / juce::jmax (16, blockSize) * blockBytes + rate * channels * (double) sizeof (float);
+
+    return juce::jmax ((juce::int64) Trace::kMinRingBytes, (juce::int64) std::ceil (perSecond * Trace::kRingSeconds));
+}
+
+bool TraceRecorder::reserveRing (juce::int64 bytes, bool force)
+{
+    // Sans audio, le tampon est petit (quelques centaines de Ko): accordé hors plafond
+    auto total = totalRingBytes.load();
+    do
+    {
+        if (! force && total + bytes > Trace::kMaxTotalRingBytes)
+            return false;
+    }
+    while (! totalRingBytes.compare_exchange_weak (total, total + bytes));
+
+    ringBytes = bytes;
+    return true;
+}
+
+//==============================================================================
+double TraceRecorder::nowNs() const noexcept
+{
+    return (double) (juce::Time::getHighResolutionTicks() - startTicks) * nsPerTick;
+}
+
+void TraceRecorder::prepared (double sampleRate, int blockSize, int mainChannels, int sidechainChannels)
+{
+    juce::MemoryOutputStream out;
+    out.writeDouble (sampleRate);
+    out.writeInt (blockSize);
+    out.writeInt (mainChannels);
+    out.writeInt (sidechainChannels);
+    pushControl (Trace::prepareRecord, out.getData(), out.getDataSize());
+}
+
+void TraceRecorder::stateRestored (const void* data, int sizeInBytes)
+{
+    pushControl (Trace::stateRecord, data, (size_t) juce::jmax (0, sizeInBytes));
+}
+
+void TraceRecorder::programChanged (int index)
+{
+    juce::MemoryOutputStream out;
+    out.writeInt (index);
+    pushControl (Trace::programRecord, out.getData(), out.getDataSize());
+}
+
+void TraceRecorder::pushControl (Trace::RecordType type, const void* data, size_t size)
+{
+    if (! active.load())
+        return;
+
+    const juce::ScopedLock sl (controlLock);
+
+    // Index lu sous verrou: croissant dans l'ordre de la file. Tous les blocs
+    // précédents sont déjà dans la FIFO (ou comptés perdus).
+    Control c;
+    c.type = type;
+    c.blockIndex = blocksPushed.load (std::memory_order_acquire);
+
+    {
+        juce::MemoryOutputStream out (c.payload, false);
+        out.writeInt64 ((juce::int64) c.blockIndex);
+        out.writeInt64 ((juce::int64) juce::jmax (0.0, nowNs()));
+        out.write (data, size);
+    }
+
+    controls.push_back (std::move (c));
+}
+
+//==============================================================================
+bool TraceRecorder::openBlock (int numSamples, int numChannels, uint8_t flags) noexcept
+{
+    // Paramètres modifiés depuis le dernier bloc enregistré (capacité réservée)
+    changed.clear();
+    for (size_t i = 0; i < params.size(); ++i)
+    {
+        const float v = params[i]->getValue();
+        if (! (v == lastValues[i]))
+            changed.emplace_back ((uint16_t) i, v);
+    }
+
+    const int payload = Trace::kBlockFixedBytes + (int) changed.size() * Trace::kChangeBytes
+                      + numChannels * numSamples * (int) sizeof (float);
+    const int total = (int) sizeof (uint32_t) + payload;
+
+    // FIFO pleine (écrivain en retard): bloc perdu, signalé au suivant
+    if (fifo->getFreeSpace() < total)
+    {
+        ++droppedSinceLast;
+        droppedTotal.fetch_add (1, std::memory_order_relaxed);
+        return false;
+    }
+
+    fifo->prepareToWrite (total, cursor.start1, cursor.size1, cursor.start2, cursor.size2);
+    cursor.ring = ring.data();
+    cursor.pos  = 0;
+
+    const auto size        = (uint32_t) payload;
+    const auto index       = (uint64_t) blocksPushed.load (std::memory_order_relaxed);
+    const auto startNs     = (uint64_t) juce::jmax (0.0, (double) (blockStartTicks - startTicks) * nsPerTick);
+    const auto samples     = (int32_t) numSamples;
+    const auto channels    = (uint16_t) numChannels;
+    const auto numChanged  = (uint8_t) changed.size();
+    const auto dropped     = (uint32_t) droppedSinceLast;
+
+    cursor.write (&size, sizeof (size));
+    cursor.write (&index, sizeof (index));
+    cursor.write (&startNs, sizeof (startNs));
+    cursor.write (&samples, sizeof (samples));
+    cursor.write (&channels, sizeof (channels));
+    cursor.write (&flags, sizeof (flags));
+    cursor.write (&numChanged, sizeof (numChanged));
+    cursor.write (&dropped, sizeof (dropped));
+
+    for (const auto& [param, value] : changed)
+    {
+        cursor.write (&param, sizeof (param));
+        cursor.write (&value, sizeof (value));
+        lastValues[param] = value;
+    }
+
+    droppedSinceLast = 0;
+    openSize  = total;
+    blockOpen = true;
+    return true;
+}
+
+void TraceRecorder::endBlock() noexcept
+{
+    if (blockOpen)
+    {
+        // Durée en fin d'enregistrement: connue seulement après le traitement
+        const double ns = (double) (juce::Time::getHighResolutionTicks() - blockStartTicks) * nsPerTick;
+        const auto durationNs = (uint32_t) juce::jlimit (0.0, 4.0e9, ns);
+        cursor.write (&durationNs, sizeof (durationNs));
+
+        fifo->finishedWrite (openSize);
+        blockOpen = false;
+    }
+
+    if (blockTraced)
+        blocksPushed.fetch_add (1, std::memory_order_release);
+
+    inBlock.store (false);
+}
+
+//==============================================================================
+int TraceRecorder::useTimeSlice()
+{
+    drain();
+    return 5;
+}
+
+void TraceRecorder::drain()
+{
+    // Borne lue avant la file: un événement arrivé après porte un index ≥ limit,
+    // les blocs au-delà attendent le passage suivant
+    const auto limit = blocksPushed.load (std::memory_order_acquire);
+
+    std::vector<Control> pending;
+    {
+        const juce::ScopedLock sl (controlLock);
+        pending.swap (controls);
+    }
+
+    for (const auto& c : pending)
+    {
+        drainBlocks (c.blockIndex);
+        writeRecord (c.type, c.payload.getData(), c.payload.getSize());
+    }
+
+    drainBlocks (limit);
+
+    // Fichier lisible jusqu'au crash éventuel de l'hôte, à ~250 ms près
+    const auto now = juce::Time::getMillisecondCounter();
+    if (now - lastFlushMs >= 250)
+    {
+        stream->flush();
+        lastFlushMs = now;
+    }
+}
+
+void TraceRecorder::drainBlocks (juce::uint64 limit)
+{
+    constexpr int kPeekBytes = (int) (sizeof (uint32_t) + sizeof (uint64_t));
+
+    while (fifo->getNumReady() >= kPeekBytes)
+    {
+        char head[kPeekBytes];
+        readFifo (head, kPeekBytes, false);
+
+        uint32_t size;
+        uint64_t index;
+        std::memcpy (&size, head, sizeof (size));
+        std::memcpy (&index, head + sizeof (size), sizeof (index));
+
+        if (index >= limit)
+            break;
+
+        // Enregistrement publié en entier par finishedWrite
+        const int total = (int) sizeof (uint32_t) + (int) size;
+        scratch.ensureSize ((size_t) total);
+        readFifo (scratch.getData(), total, true);
+
+        writeRecord (Trace::blockRecord, static_cast<const char*> (scratch.getData()) + sizeof (uint32_t), size);
+    }
+}
+
+bool TraceRecorder::readFifo (void* dest, int numBytes, bool consume) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo->prepareToRead (numBytes, start1, size1, start2, size2);
+
+    if (size1 + size2 < numBytes)
+        return false;
+
+    auto* bytes = static_cast<char*> (dest);
+    std::memcpy (bytes, ring.data() + start1, (size_t) size1);
+    if (size2 > 0)
+        std::memcpy (bytes + size1, ring.data() + start2, (size_t) size2);
+
+    if (consume)
+        fifo->finishedRead (numBytes);
+
+    return true;
+}
+
+void TraceRecorder::writeRecord (Trace::RecordType type, const void* data, size_t size)
+{
+    stream->writeByte ((char) type);
+    stream->writeInt ((int) size);
+    stream->write (data, size);
+}
+
+//==============================================================================
+bool TraceReader::open (const juce::File& f)
+{
+    stream = std::make_unique<juce::FileInputStream> (f);
+    if (! stream->openedOk())
+        return false;
+
+    if ((uint32_t) stream->readInt() != Trace::kMagic || (uint32_t) stream->readInt() > Trace::kVersion)
+        return false;
+
+    audio = stream->readByte() != 0;
+    hostDescription = stream->readString();
+
+    parameterIds.clear();
+    const int numParams = stream->readInt();
+    for (int i = 0; i < juce::jlimit (0, Trace::kMaxParameters, numParams); ++i)
+        parameterIds.add (stream->readString());
+
+    // En-tête sans enregistrement (trace arrêtée avant le premier bloc): rejeu vide, pas une erreur
+    return true;
+}
+
+bool TraceReader::next (Event& e)
+{
+    constexpr int kRecordHeader = 1 + 4;
+
+    for (;;)
+    {
+        if (stream == nullptr || stream->getNumBytesRemaining() < kRecordHeader)
+            return false;
+
+        const auto type = (uint8_t) stream->readByte();
+        const int size  = stream->readInt();
+
+        // Dernier enregistrement tronqué: fin de la trace
+        if (size < 0 || stream->getNumBytesRemaining() < size)
+            return false;
+
+        scratch.setSize ((size_t) size);
+        stream->read (scratch.getData(), size);
+        juce::MemoryInputStream in (scratch, false);
+
+        e.type       = (Trace::RecordType) type;
+        e.blockIndex = (juce::uint64) in.readInt64();
+        e.timeNs     = (juce::uint64) in.readInt64();
+
+        switch (type)
+        {
+            case Trace::prepareRecord:
+                e.sampleRate        = in.readDouble();
+                e.blockSize         = in.readInt();
+                e.mainChannels      = in.readInt();
+                e.sidechainChannels = in.readInt();
+                return true;
+
+            case Trace::stateRecord:
+                e.state = juce::MemoryBlock (static_cast<const char*> (scratch.getData()) + in.getPosition(),
+                                             (size_t) in.getNumBytesRemaining());
+                return true;
+
+            case Trace::programRecord:
+                e.program = in.readInt();
+                return true;
+
+            case Trace::blockRecord:
+            {
+                e.numSamples = in.readInt();
+                const int numChannels = (uint16_t) in.readShort();
+                const auto flags      = (uint8_t) in.readByte();
+                const int numChanged  = (uint8_t) in.readByte();
+                e.droppedBefore       = (juce::uint32) in.readInt();
+                e.doublePrecision     = (flags & Trace::doublePrecision) != 0;
+
+                // Champs incohérents avec la taille déclarée (trace corrompue):
+                // fin de la lecture, avant toute allocation demandée par le fichier
+                const auto expected = (juce::int64) Trace::kBlockFixedBytes + numChanged * Trace::kChangeBytes
+                                    + (juce::int64) numChannels * e.numSamples * (juce::int64) sizeof (float);
+
+                if (e.numSamples < 0 || expected != size
+                     || (numChannels > 0 && (flags & Trace::withAudio) == 0))
+                    return false;
+
+                e.changes.clear();
+                for (int i = 0; i < numChanged; ++i)
+                {
+                    const int param = (uint16_t) in.readShort();
+                    e.changes.emplace_back (param, in.readFloat());
+                }
+
+                if ((flags & Trace::withAudio) != 0 && numChannels > 0 && e.numSamples > 0)
+                {
+                    e.input.setSize (numChannels, e.numSamples, false, false, true);
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        in.read (e.input.getWritePointer (ch), e.numSamples * (int) sizeof (float));
+                }
+                else
+                {
+                    e.input.setSize (0, 0);
+                }
+
+                e.durationNs = (juce::uint32) in.readInt();
+                return true;
+            }
+
+            default:
+                break;      // type inconnu (version ultérieure): ignoré
+        }
+    }
+}
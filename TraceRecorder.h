@@ -0,0 +1,266 @@
+//============================== TraceRecorder.h ===============================
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Trace de production du processeur (opt-in), rejouable hors ligne.
+ *
+ * Chaque processBlock produit un enregistrement binaire: taille de bloc,
+ * paramètres modifiés depuis le bloc précédent, horodatage et durée du
+ * traitement, et en option l'audio d'entrée (sidechain compris). Le thread
+ * audio écrit dans une FIFO d'octets sans verrou. prepareToPlay,
+ * setStateInformation et les changements de programme passent par une file
+ * du thread message. Un TimeSliceThread partagé écrit les deux dans l'ordre
+ * des blocs.
+ *
+ * Fichier: en-tête (identifiants des paramètres), puis suite
+ * d'enregistrements [type u8][taille u32][données], en little-endian. Un
+ * fichier tronqué (crash de l'hôte) reste lisible jusqu'au dernier
+ * enregistrement complet. FIFO pleine: blocs perdus comptés dans
+ * l'enregistrement suivant.
+ */
+namespace Trace
+{
+    constexpr uint32_t kMagic   = 0x52545053;   // "SPTR"
+    constexpr uint32_t kVersion = 1;
+
+    enum RecordType : uint8_t
+    {
+        prepareRecord = 1,
+        stateRecord,
+        programRecord,
+        blockRecord
+    };
+
+    enum BlockFlags : uint8_t
+    {
+        doublePrecision = 1,
+        withAudio       = 2
+    };
+
+    // Octets fixes d'un bloc: index, début, échantillons, canaux, drapeaux,
+    // nb de paramètres, blocs perdus, durée (en fin d'enregistrement)
+    constexpr int kBlockFixedBytes = 8 + 8 + 4 + 2 + 1 + 1 + 4 + 4;
+    constexpr int kChangeBytes     = 2 + 4;     // index u16 + valeur normalisée f32
+    constexpr int kMaxParameters   = 255;
+
+    // FIFO audio → écrivain: kRingSeconds de marge au débit courant, toutes instances plafonnées
+    constexpr double kRingSeconds            = 4.0;
+    constexpr int    kMinRingBytes           = 1 << 16;
+    constexpr juce::int64 kMaxTotalRingBytes = (juce::int64) 64 << 20;
+}
+
+//==============================================================================
+/** Écrivain: un par processeur, inactif tant que start() n'a pas été appelé. */
+class TraceRecorder : private juce::TimeSliceClient
+{
+public:
+    TraceRecorder();
+    ~TraceRecorder() override;
+
+    // Thread message. initialState = getStateInformation() au démarrage.
+    bool start (const juce::File& file, juce::AudioProcessor& processor, bool captureAudio,
+                const juce::MemoryBlock& initialState);
+    void stop();
+
+    bool isRecording() const noexcept                   { return active.load(); }
+    juce::File getFile() const                          { return file; }
+    juce::uint64 getDroppedBlocks() const noexcept      { return droppedTotal.load (std::memory_order_relaxed); }
+
+    // Threads non audio: événements replacés entre les blocs
+    void prepared (double sampleRate, int blockSize, int mainChannels, int sidechainChannels);
+    void stateRestored (const void* data, int sizeInBytes);
+    void programChanged (int index);
+
+    // Thread audio: encadre le traitement d'un bloc (entrée lue avant traitement)
+    template <typename Sample>
+    class ScopedBlock
+    {
+    public:
+        ScopedBlock (TraceRecorder& r, const juce::AudioBuffer<Sample>& buffer, int numInputChannels) noexcept
+            : recorder (r)
+        {
+            recorder.beginBlock (buffer, numInputChannels);
+        }
+
+        ~ScopedBlock() noexcept     { recorder.endBlock(); }
+
+    private:
+        TraceRecorder& recorder;
+        JUCE_DECLARE_NON_COPYABLE (ScopedBlock)
+    };
+
+private:
+    // Écriture d'un enregistrement dans les deux zones réservées de la FIFO
+    struct FifoCursor
+    {
+        char* ring = nullptr;
+        int start1 = 0, size1 = 0, start2 = 0, size2 = 0, pos = 0;
+
+        void write (const void* src, int numBytes) noexcept;
+    };
+
+    template <typename Sample>
+    void beginBlock (const juce::AudioBuffer<Sample>& buffer, int numInputChannels) noexcept;
+    bool openBlock (int numSamples, int numChannels, uint8_t flags) noexcept;
+    void endBlock() noexcept;
+
+    static juce::int64 ringBytesFor (const juce::AudioProcessor&, bool withAudio);
+    bool reserveRing (juce::int64 bytes, bool force);
+
+    double nowNs() const noexcept;
+    void pushControl (Trace::RecordType, const void* data, size_t size);
+    void writeRecord (Trace::RecordType, const void* data, size_t size);
+    bool readFifo (void* dest, int numBytes, bool consume) noexcept;
+
+    int useTimeSlice() override;
+    void drain();
+    void drainBlocks (juce::uint64 limit);
+
+    //==============================================================================
+    juce::File file;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    bool captureAudio = false;
+
+    // Paramètres suivis (ordre = en-tête du fichier)
+    std::vector<juce::AudioProcessorParameter*> params;
+    std::vector<float> lastValues;
+    std::vector<std::pair<uint16_t, float>> changed;
+
+    // Thread audio → écrivain
+    std::vector<char> ring;
+    juce::int64 ringBytes = 0;
+    static inline std::atomic<juce::int64> totalRingBytes { 0 };   // toutes instances
+    std::unique_ptr<juce::AbstractFifo> fifo;
+    FifoCursor cursor;
+    int openSize = 0;
+    bool blockTraced = false, blockOpen = false;
+    juce::int64 blockStartTicks = 0;
+    juce::uint32 droppedSinceLast = 0;
+
+    juce::int64 startTicks = 0;
+    double nsPerTick = 0.0;
+
+    std::atomic<bool> active { false }, inBlock { false };
+    std::atomic<juce::uint64> blocksPushed { 0 }, droppedTotal { 0 };
+
+    // Thread message → écrivain (rare: verrou acceptable hors audio)
+    struct Control
+    {
+        juce::uint64 blockIndex = 0;
+        Trace::RecordType type = Trace::prepareRecord;
+        juce::MemoryBlock payload;
+    };
+
+    juce::CriticalSection controlLock;
+    std::vector<Control> controls;
+
+    // Écrivain uniquement
+    juce::MemoryBlock scratch;
+    juce::uint32 lastFlushMs = 0;
+
+    struct SharedThread : public juce::TimeSliceThread
+    {
+        SharedThread() : juce::TimeSliceThread ("Spectra Trace") { startThread(); }
+        ~SharedThread() override { stopThread (2000); }
+    };
+
+    juce::SharedResourcePointer<SharedThread> thread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TraceRecorder)
+};
+
+//==============================================================================
+/** Lecture séquentielle d'une trace (banc de rejeu, outils hors ligne). */
+class TraceReader
+{
+public:
+    struct Event
+    {
+        Trace::RecordType type = Trace::blockRecord;
+        juce::uint64 blockIndex = 0;
+        juce::uint64 timeNs = 0;            // depuis le début de la trace
+
+        // prepareRecord
+        double sampleRate = 0.0;
+        int blockSize = 0, mainChannels = 0, sidechainChannels = 0;
+
+        // stateRecord / programRecord
+        juce::MemoryBlock state;
+        int program = -1;
+
+        // blockRecord
+        int numSamples = 0;
+        bool doublePrecision = false;
+        juce::uint32 durationNs = 0, droppedBefore = 0;
+        std::vector<std::pair<int, float>> changes;     // index de paramètre, valeur normalisée
+        juce::AudioBuffer<float> input;                 // vide sans capture audio
+    };
+
+    bool open (const juce::File&);
+
+    const juce::StringArray& getParameterIds() const noexcept   { return parameterIds; }
+    const juce::String& getHostDescription() const noexcept     { return hostDescription; }
+    bool hasAudio() const noexcept                              { return audio; }
+
+    // false en fin de fichier ou sur un enregistrement incomplet
+    bool next (Event&);
+
+private:
+    std::unique_ptr<juce::FileInputStream> stream;
+    juce::StringArray parameterIds;
+    juce::String hostDescription;
+    bool audio = false;
+    juce::MemoryBlock scratch;
+};
+
+//==============================================================================
+template <typename Sample>
+void TraceRecorder::beginBlock (const juce::AudioBuffer<Sample>& buffer, int numInputChannels) noexcept
+{
+    // Ordre séquentiel avec stop(): soit le bloc voit 'active' faux, soit stop() attend sa fin
+    inBlock.store (true);
+    blockTraced = blockOpen = false;
+
+    if (! active.load())
+        return;
+
+    blockTraced = true;
+
+    blockStartTicks = juce::Time::getHighResolutionTicks();
+
+    const int numSamples  = buffer.getNumSamples();
+    const int numChannels = captureAudio ? juce::jlimit (0, buffer.getNumChannels(), numInputChannels) : 0;
+    const uint8_t flags   = (uint8_t) ((std::is_same_v<Sample, double> ? Trace::doublePrecision : 0)
+                                     | (captureAudio ? Trace::withAudio : 0));
+
+    if (! openBlock (numSamples, numChannels, flags))
+        return;
+
+    // Audio d'entrée en float32, canal par canal
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* x = buffer.getReadPointer (ch);
+
+        if constexpr (std::is_same_v<Sample, float>)
+        {
+            cursor.write (x, numSamples * (int) sizeof (float));
+        }
+        else
+        {
+            float tmp[256];
+            for (int i = 0; i < numSamples; i += 256)
+            {
+                const int n = juce::jmin (256, numSamples - i);
+                for (int k = 0; k < n; ++k)
+                    tmp[k] = (float) x[i + k];
+
+                cursor.write (tmp, n * (int) sizeof (float));
+            }
+        }
+    }
+}